@@ -0,0 +1,68 @@
+#include "atoms.h"
+
+#include <X11/Xlib.h>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "ewmh.h"
+#include "globals.h"
+#include "utils.h"
+
+using std::string;
+using std::vector;
+
+Atom g_atom[AtomCOUNT];
+Atom g_hook_atom[HERBST_HOOK_PROPERTY_COUNT];
+
+/* list of names of all atoms */
+const std::array<const char*,AtomCOUNT> g_atom_names =
+  ArrayInitializer<const char*,AtomCOUNT>({
+    { AtomUtf8String                 , "UTF8_STRING"                       },
+    { AtomWmState                    , "WM_STATE"                          },
+    { AtomWmProtocols                , "WM_PROTOCOLS"                      },
+    { AtomWmDeleteWindow             , "WM_DELETE_WINDOW"                  },
+    { AtomWmTakeFocus                , "WM_TAKE_FOCUS"                     },
+    { AtomWmWindowRole               , "WM_WINDOW_ROLE"                    },
+    { AtomNetWmPid                   , "_NET_WM_PID"                       },
+    { AtomHerbstHookWinId            , HERBST_HOOK_WIN_ID_ATOM             },
+    { AtomHerbstIpcArgs              , HERBST_IPC_ARGS_ATOM                },
+    { AtomHerbstIpcOutput            , HERBST_IPC_OUTPUT_ATOM              },
+    { AtomHerbstIpcStatus            , HERBST_IPC_STATUS_ATOM              },
+}).a;
+
+void atoms_init() {
+    // collect all names such that we need only one round trip
+    vector<string> hook_names;
+    for (int i = 0; i < HERBST_HOOK_PROPERTY_COUNT; i++) {
+        char atom_name[STRING_BUF_SIZE];
+        snprintf(atom_name, STRING_BUF_SIZE, HERBST_HOOK_PROPERTY_FORMAT, i);
+        hook_names.push_back(atom_name);
+    }
+    vector<char*> names;
+    vector<Atom*> targets;
+    for (int i = 0; i < AtomCOUNT; i++) {
+        names.push_back((char*)g_atom_names[i]);
+        targets.push_back(g_atom + i);
+    }
+    for (int i = 0; i < NetCOUNT; i++) {
+        if (!g_netatom_names[i]) {
+            HSWarning("no name specified in g_netatom_names "
+                      "for atom number %d\n", i);
+            g_netatom[i] = None;
+            continue;
+        }
+        names.push_back((char*)g_netatom_names[i]);
+        targets.push_back(g_netatom + i);
+    }
+    for (int i = 0; i < HERBST_HOOK_PROPERTY_COUNT; i++) {
+        names.push_back((char*)hook_names[i].c_str());
+        targets.push_back(g_hook_atom + i);
+    }
+    vector<Atom> atoms(names.size(), None);
+    XInternAtoms(g_display, names.data(), names.size(), False, atoms.data());
+    for (size_t i = 0; i < atoms.size(); i++) {
+        *targets[i] = atoms[i];
+    }
+}
+
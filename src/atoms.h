@@ -0,0 +1,37 @@
+#ifndef __HERBSTLUFT_ATOMS_H_
+#define __HERBSTLUFT_ATOMS_H_
+
+#include <X11/X.h>
+#include <array>
+
+#include "ipc-protocol.h"
+
+/* all atoms used by herbstluftwm that are not covered by the _NET-atoms in
+ * ewmh.h. They are interned together with the _NET-atoms in a single
+ * XInternAtoms() call by atoms_init() */
+enum {
+    AtomUtf8String = 0,
+    AtomWmState,
+    AtomWmProtocols,
+    AtomWmDeleteWindow,
+    AtomWmTakeFocus,
+    AtomWmWindowRole,
+    AtomNetWmPid,
+    AtomHerbstHookWinId,
+    AtomHerbstIpcArgs,
+    AtomHerbstIpcOutput,
+    AtomHerbstIpcStatus,
+    /* the count of atoms */
+    AtomCOUNT
+};
+
+extern Atom g_atom[AtomCOUNT];
+extern const std::array<const char*,AtomCOUNT> g_atom_names;
+
+// the atoms __HERBST_HOOK_ARGUMENTS_0 … __HERBST_HOOK_ARGUMENTS_N
+extern Atom g_hook_atom[HERBST_HOOK_PROPERTY_COUNT];
+
+void atoms_init();
+
+#endif
+
@@ -0,0 +1,191 @@
+/* bench_layout - measure the throughput of the layout computation
+ *
+ * This generates random frame trees and repeatedly computes their layout
+ * with layout_leaf_frame() and layout_split_frame() into a TilingResult,
+ * which is the code the frame tree in herbstluftwm runs, too. The nodes of
+ * the trees implement the FrameLayout interface like HSFrameLeaf and
+ * HSFrameSplit, but without tag and decoration objects, so no X server is
+ * needed. Besides the throughput, it reports the number of heap allocations
+ * per layout, counted by the operator new below.
+ *
+ * Usage: bench_layout [ITERATIONS [SEED]]
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "framelayout.h"
+#include "layoutgeometry.h"
+#include "tilingresult.h"
+
+using std::chrono::duration;
+using std::chrono::steady_clock;
+using std::mt19937;
+using std::uniform_int_distribution;
+using std::unique_ptr;
+using std::vector;
+
+static size_t g_allocations = 0;
+
+void* operator new(size_t size) {
+    g_allocations++;
+    void* ptr = malloc(size ? size : 1);
+    if (!ptr) {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+void operator delete(void* ptr) noexcept {
+    free(ptr);
+}
+
+// the layout only passes the clients through to the TilingResult, so the
+// leaves hold null pointers instead of Client objects
+class BenchLeaf : public FrameLayout {
+public:
+    void computeLayout(Rectangle rect, const LayoutSettings& settings,
+                       TilingResult& res) override {
+        LeafLayout leaf = {
+            clients, selection, layout, hasParent, coversTile, nullptr,
+        };
+        layout_leaf_frame(rect, settings, leaf, res);
+    }
+    vector<Client*> clients;
+    int selection = 0;
+    int layout = LAYOUT_VERTICAL;
+    bool hasParent = true;
+    bool coversTile = true;
+};
+
+class BenchSplit : public FrameLayout {
+public:
+    void computeLayout(Rectangle rect, const LayoutSettings& settings,
+                       TilingResult& res) override {
+        layout_split_frame(rect, settings, align == ALIGN_VERTICAL, fraction,
+                           selection, *a, *b, res);
+    }
+    int align = ALIGN_VERTICAL;
+    int fraction = FRACTION_UNIT / 2;
+    int selection = 0;
+    unique_ptr<FrameLayout> a;
+    unique_ptr<FrameLayout> b;
+};
+
+struct Tree {
+    unique_ptr<FrameLayout> root;
+    size_t leaves = 0;
+    size_t clients = 0;
+    size_t depth = 0;
+};
+
+static unique_ptr<FrameLayout> random_leaf(mt19937& rng, Tree& tree) {
+    unique_ptr<BenchLeaf> leaf(new BenchLeaf);
+    leaf->layout = uniform_int_distribution<int>(0, LAYOUT_COUNT - 1)(rng);
+    leaf->clients.resize(uniform_int_distribution<size_t>(0, 6)(rng));
+    if (leaf->clients.size() > 0) {
+        leaf->selection = uniform_int_distribution<int>(
+                0, (int)leaf->clients.size() - 1)(rng);
+    }
+    tree.leaves++;
+    tree.clients += leaf->clients.size();
+    return unique_ptr<FrameLayout>(leaf.release());
+}
+
+static unique_ptr<BenchSplit> random_split(mt19937& rng) {
+    unique_ptr<BenchSplit> split(new BenchSplit);
+    split->align = uniform_int_distribution<int>(ALIGN_VERTICAL,
+                                                 ALIGN_HORIZONTAL)(rng);
+    split->fraction = uniform_int_distribution<int>(FRACTION_UNIT / 10,
+                                                    FRACTION_UNIT * 9 / 10)(rng);
+    split->selection = uniform_int_distribution<int>(0, 1)(rng);
+    return split;
+}
+
+// a balanced tree with 2^depth leaves
+static unique_ptr<FrameLayout> random_wide(mt19937& rng, Tree& tree,
+                                           size_t depth) {
+    if (depth == 0) {
+        return random_leaf(rng, tree);
+    }
+    auto split = random_split(rng);
+    split->a = random_wide(rng, tree, depth - 1);
+    split->b = random_wide(rng, tree, depth - 1);
+    return unique_ptr<FrameLayout>(split.release());
+}
+
+// a degenerated tree where every split has a leaf and a split as children
+static unique_ptr<FrameLayout> random_deep(mt19937& rng, Tree& tree,
+                                           size_t depth) {
+    if (depth == 0) {
+        return random_leaf(rng, tree);
+    }
+    auto split = random_split(rng);
+    auto leaf = random_leaf(rng, tree);
+    auto rest = random_deep(rng, tree, depth - 1);
+    if (uniform_int_distribution<int>(0, 1)(rng)) {
+        split->a = std::move(leaf);
+        split->b = std::move(rest);
+    } else {
+        split->a = std::move(rest);
+        split->b = std::move(leaf);
+    }
+    return unique_ptr<FrameLayout>(split.release());
+}
+
+static void run(const char* name, const Tree& tree, size_t iterations) {
+    Rectangle screen = { 0, 0, 3840, 2160 };
+    // all gaps and paddings are set, such that every step of the
+    // computation has an effect
+    LayoutSettings settings;
+    settings.frameGap = 5;
+    settings.frameBorderWidth = 2;
+    settings.windowGap = 4;
+    settings.framePadding = 1;
+    settings.gaplessGrid = true;
+    size_t allocations = g_allocations;
+    auto start = steady_clock::now();
+    for (size_t i = 0; i < iterations; i++) {
+        // like Monitor::applyLayout()
+        TilingResult res;
+        res.reserve(tree.clients, tree.leaves);
+        tree.root->computeLayout(screen, settings, res);
+    }
+    duration<double> elapsed = steady_clock::now() - start;
+    allocations = g_allocations - allocations;
+    printf("%-6s depth=%-4zu frames=%-6zu clients=%-6zu "
+           "%12.0f layouts/s %8.3f us/layout %6.2f allocs/layout\n",
+           name, tree.depth, tree.leaves, tree.clients,
+           iterations / elapsed.count(),
+           elapsed.count() * 1e6 / iterations,
+           (double)allocations / iterations);
+}
+
+int main(int argc, char** argv) {
+    size_t iterations = (argc > 1) ? strtoul(argv[1], nullptr, 10) : 20000;
+    unsigned long seed = (argc > 2) ? strtoul(argv[2], nullptr, 10) : 42;
+    if (iterations == 0) {
+        fprintf(stderr, "usage: %s [ITERATIONS [SEED]]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+    mt19937 rng(seed);
+    for (size_t depth : { 2, 5, 8 }) {
+        Tree tree;
+        tree.depth = depth;
+        tree.root = random_wide(rng, tree, depth);
+        run("wide", tree, iterations);
+    }
+    for (size_t depth : { 8, 32, 128 }) {
+        Tree tree;
+        tree.depth = depth;
+        tree.root = random_deep(rng, tree, depth);
+        run("deep", tree, iterations);
+    }
+    return EXIT_SUCCESS;
+}
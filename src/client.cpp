@@ -7,6 +7,7 @@
 #include <cstring>
 #include <sstream>
 
+#include "atoms.h"
 #include "clientmanager.h"
 #include "decoration.h"
 #include "ewmh.h"
@@ -28,11 +29,6 @@ using std::string;
 
 static int g_monitor_float_treshold = 24;
 
-// atoms from dwm.c
-// default atoms
-enum { WMProtocols, WMDelete, WMState, WMTakeFocus, WMLast };
-static Atom g_wmatom[WMLast];
-
 static Client* lastfocus = nullptr;
 
 
@@ -40,6 +36,7 @@ Client::Client(Window window, bool visible_already, ClientManager& cm)
     : window_(window)
     , dec(this, *cm.settings)
     , visible_(visible_already)
+    , mapped_(visible_already)
     , urgent_(this, "urgent", false)
     , fullscreen_(this,  "fullscreen", false)
     , title_(this,  "title", "")
@@ -69,11 +66,15 @@ Client::Client(Window window, bool visible_already, ClientManager& cm)
 }
 
 void Client::init_from_X() {
+    XConnection& X = Root::get()->X;
+    // send both requests before waiting for any reply
+    auto size = X.windowSizeAsync(window_);
+    auto pid = X.windowPidAsync(window_);
     // treat wanted coordinates as floating coords
-    float_size_ = Root::get()->X.windowSize(window_);
+    float_size_ = size.get();
     last_size_ = float_size_;
 
-    pid_ = Root::get()->X.windowPid(window_);
+    pid_ = pid.get();
 
     update_title();
     update_wm_hints();
@@ -101,15 +102,6 @@ void Client::make_full_client() {
     XSelectInput(g_display, window_, CLIENT_EVENT_MASK);
 }
 
-void clientlist_init() {
-    // init regex simple..
-    g_wmatom[WMProtocols] = XInternAtom(g_display, "WM_PROTOCOLS", False);
-    g_wmatom[WMDelete] = XInternAtom(g_display, "WM_DELETE_WINDOW", False);
-    g_wmatom[WMState] = XInternAtom(g_display, "WM_STATE", False);
-    g_wmatom[WMTakeFocus] = XInternAtom(g_display, "WM_TAKE_FOCUS", False);
-    // init actual client list
-}
-
 bool Client::ignore_unmapnotify() {
     if (ignore_unmaps_ > 0) {
         ignore_unmaps_--;
@@ -123,9 +115,6 @@ void reset_client_colors() {
     all_monitors_apply_layout();
 }
 
-void clientlist_destroy() {
-}
-
 Client* get_client_from_window(Window window) {
     return Root::get()->clients()->client(window);
 }
@@ -178,7 +167,7 @@ void Client::window_focus() {
     if (!this->neverfocus_) {
         XSetInputFocus(g_display, this->window_, RevertToPointerRoot, CurrentTime);
     }
-    else this->sendevent(g_wmatom[WMTakeFocus]);
+    else this->sendevent(g_atom[AtomWmTakeFocus]);
 
     if (this != lastfocus) {
         /* FIXME: this is a workaround because window_focus always is called
@@ -233,6 +222,7 @@ void Client::setup_border(bool focused) {
 }
 
 void Client::resize_fullscreen(Rectangle monitor_rect, bool isFocused) {
+    tiling_rect_.width = -1;
     dec.resize_outline(monitor_rect, theme[Theme::Type::Fullscreen](isFocused,urgent_()));
 }
 
@@ -241,6 +231,7 @@ void Client::raise() {
 }
 
 void Client::resize_tiling(Rectangle rect, bool isFocused) {
+    tiling_rect_ = rect;
     // apply border width
     if (!this->pseudotile_ /* && !smart_window_surroundings_active(frame) */) {
         // apply window gap
@@ -386,8 +377,22 @@ void Client::send_configure() {
     XSendEvent(g_display, this->window_, False, StructureNotifyMask, (XEvent *)&ce);
 }
 
+bool Client::isTiledWithin(Rectangle rect) {
+    return tiling_rect_.width >= 0
+        && rect.x <= tiling_rect_.x
+        && rect.y <= tiling_rect_.y
+        && tiling_rect_.x + tiling_rect_.width <= rect.x + rect.width
+        && tiling_rect_.y + tiling_rect_.height <= rect.y + rect.height;
+}
+
+bool Client::coversTile() {
+    // size hints and pseudotiling may shrink the client within its tile
+    return !pseudotile_() && !sizehints_tiling_ && !dec.hasAlpha();
+}
+
 void Client::resize_floating(Monitor* m, bool isFocused) {
     if (!m) return;
+    tiling_rect_.width = -1;
     auto rect = this->float_size_;
     rect.x += m->rect.x;
     rect.x += m->rect.y;
@@ -430,9 +435,9 @@ void window_close(Window window) {
     XEvent ev;
     ev.type = ClientMessage;
     ev.xclient.window = window;
-    ev.xclient.message_type = g_wmatom[WMProtocols];
+    ev.xclient.message_type = g_atom[AtomWmProtocols];
     ev.xclient.format = 32;
-    ev.xclient.data.l[0] = g_wmatom[WMDelete];
+    ev.xclient.data.l[0] = g_atom[AtomWmDeleteWindow];
     ev.xclient.data.l[1] = CurrentTime;
     XSendEvent(g_display, window, False, NoEventMask, &ev);
 }
@@ -454,7 +459,17 @@ void window_set_visible(Window win, bool visible) {
 
 void Client::set_visible(bool visible) {
     if (visible == this->visible_) return;
-    if (visible) {
+    if (tag_ && tag_->hasContainer()) {
+        /* the container window of the tag hides the client, so the windows
+           stay mapped and only the WM_STATE changes */
+        if (visible && !mapped_) {
+            XMapWindow(g_display, this->window_);
+            XMapWindow(g_display, this->dec.decorationWindow());
+            mapped_ = true;
+        }
+        window_update_wm_state(this->window_,
+                               visible ? WmStateNormalState : WmStateIconicState);
+    } else if (visible) {
         /* Grab the server to make sure that the frame window is mapped before
            the client gets its MapNotify, i.e. to make sure the client is
            _visible_ when it gets MapNotify. */
@@ -463,17 +478,35 @@ void Client::set_visible(bool visible) {
         XMapWindow(g_display, this->window_);
         XMapWindow(g_display, this->dec.decorationWindow());
         XUngrabServer(g_display);
+        mapped_ = true;
     } else {
-        /* we unmap the client itself so that we can get MapRequest
-           events, and because the ICCCM tells us to! */
-        XUnmapWindow(g_display, this->dec.decorationWindow());
-        XUnmapWindow(g_display, this->window_);
-        window_update_wm_state(this->window_, WmStateWithdrawnState);
-        this->ignore_unmaps_++;
+        unmapWindows();
     }
     this->visible_ = visible;
 }
 
+void Client::unmapWindows() {
+    /* we unmap the client itself so that we can get MapRequest
+       events, and because the ICCCM tells us to! */
+    XUnmapWindow(g_display, this->dec.decorationWindow());
+    XUnmapWindow(g_display, this->window_);
+    window_update_wm_state(this->window_, WmStateWithdrawnState);
+    this->ignore_unmaps_++;
+    mapped_ = false;
+}
+
+void Client::setDecorationParent(Window parent) {
+    if (!dec.decorationWindow()) {
+        return;
+    }
+    if (mapped_ && !visible_) {
+        // hidden clients only stay mapped within the container of their tag
+        unmapWindows();
+    }
+    auto outer = dec.last_outer();
+    XReparentWindow(g_display, dec.decorationWindow(), parent, outer.x, outer.y);
+}
+
 // heavily inspired by dwm.c
 void Client::set_urgent(bool state) {
     if (this->urgent_() == state) {
@@ -488,7 +521,7 @@ void Client::set_urgent_force(bool state) {
     snprintf(winid_str, STRING_BUF_SIZE, "0x%lx", this->window_);
     hook_emit_list("urgent", state ? "on" : "off", winid_str, nullptr);
 
-    this->urgent_ = state;
+    updateUrgentAttribute(state);
 
     setup_border(this == HSFrame::getGloballyFocusedFrame()->focusedClient());
 
@@ -504,8 +537,27 @@ void Client::set_urgent_force(bool state) {
 
     XSetWMHints(g_display, this->window_, wmh);
     XFree(wmh);
-    // report changes to tags
-    tag_set_flags_dirty();
+}
+
+void Client::updateUrgentAttribute(bool state) {
+    if (tag_ && state != urgent_()) {
+        tag_->urgentClientsChanged(state ? 1 : -1);
+    }
+    urgent_ = state;
+}
+
+void Client::setTag(HSTag* tag) {
+    Window oldParent = tag_ ? tag_->decorationParent() : g_root;
+    if (tag_) {
+        tag_->clientLeft(urgent_());
+    }
+    tag_ = tag;
+    if (tag_) {
+        tag_->clientEntered(urgent_());
+        if (tag_->decorationParent() != oldParent) {
+            setDecorationParent(tag_->decorationParent());
+        }
+    }
 }
 
 // heavily inspired by dwm.c
@@ -524,12 +576,11 @@ void Client::update_wm_hints() {
     } else {
         bool newval = (wmh->flags & XUrgencyHint) ? true : false;
         if (newval != this->urgent_()) {
-            this->urgent_ = newval;
+            updateUrgentAttribute(newval);
             char winid_str[STRING_BUF_SIZE];
             snprintf(winid_str, STRING_BUF_SIZE, "0x%lx", this->window_);
             this->setup_border(focused_client == this);
             hook_emit_list("urgent", this->urgent_() ? "on":"off", winid_str, nullptr);
-            tag_set_flags_dirty();
         }
     }
     if (wmh->flags & InputHint) {
@@ -652,7 +703,7 @@ bool Client::sendevent(Atom proto) {
     if (exists) {
         ev.type = ClientMessage;
         ev.xclient.window = this->window_;
-        ev.xclient.message_type = g_wmatom[WMProtocols];
+        ev.xclient.message_type = g_atom[AtomWmProtocols];
         ev.xclient.format = 32;
         ev.xclient.data.l[0] = proto;
         ev.xclient.data.l[1] = CurrentTime;
@@ -691,6 +742,6 @@ void Client::clear_properties() {
     // that he has been unmanaged and now the client is allowed to be mapped
     // again (e.g. if it is some dialog)
     ewmh_clear_client_properties(window_);
-    XDeleteProperty(g_display, window_, g_wmatom[WMState]);
+    XDeleteProperty(g_display, window_, g_atom[AtomWmState]);
 }
 
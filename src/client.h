@@ -3,6 +3,8 @@
 
 #include <X11/X.h>
 #include <X11/Xlib.h>
+#include <set>
+#include <utility>
 
 #include "attribute_.h"
 #include "decoration.h"
@@ -14,6 +16,7 @@ class HSTag;
 class Monitor;
 class Settings;
 class ClientManager;
+class HSFrameLeaf;
 
 class Client : public Object {
 public:
@@ -24,12 +27,18 @@ public:
     Decoration  dec;
     Rectangle   last_size_;      // last size excluding the window border
     Rectangle   float_size_ = {0, 0, 100, 100};     // floating size without the window border
+    Rectangle   tiling_rect_ = {0, 0, -1, -1}; // the last tiling rect, width < 0 if not tiled
     HSTag*      tag_ = {};
+    HSFrameLeaf* frameLeaf_ = {}; // the frame holding it, maintained by the frame
     Slice* slice = {};
     bool        ewmhfullscreen_ = false; // ewmh fullscreen state
     bool        neverfocus_ = false; // do not give the focus via XSetInputFocus
     bool        visible_;
+    bool        mapped_;  // whether the window and its decoration are mapped
     bool        dragged_ = false;  // if this client is dragged currently
+    // the passive button grabs on the window, maintained by grab_client_buttons()
+    bool        clickGrabbed_ = false; // whether clicks for focusing are grabbed
+    std::set<std::pair<unsigned int, unsigned int>> bindingGrabs_; // (button, modifiers)
     int         pid_;
     int         ignore_unmaps_ = 0;  // Ignore one unmap for each reparenting
                                 // action, because reparenting creates an unmap
@@ -61,7 +70,7 @@ public:
 
     // setter and getter for attributes
     HSTag* tag() { return tag_; }
-    void setTag(HSTag* tag) { tag_ = tag; }
+    void setTag(HSTag* tag);
 
     Window x11Window() { return window_; }
     Window decorationWindow() { return dec.decorationWindow(); }
@@ -80,6 +89,10 @@ public:
     void resize_tiling(Rectangle rect, bool isFocused);
     void resize_floating(Monitor* m, bool isFocused);
     void resize_fullscreen(Rectangle m, bool isFocused);
+    //! whether the client is tiled and lies within the given tiling rect
+    bool isTiledWithin(Rectangle rect);
+    //! whether the client opaquely covers the entire tile in tiling mode
+    bool coversTile();
     bool is_client_floated();
     bool needs_minimal_dec();
     void set_urgent(bool state);
@@ -97,15 +110,21 @@ public:
     bool sendevent(Atom proto);
 
     void set_visible(bool visible_);
+    //! move the decoration window to the given parent: the root window or
+    //! the container window of a tag
+    void setDecorationParent(Window parent);
 
     void set_fullscreen(bool state);
     void set_pseudotile(bool state);
     void set_urgent_force(bool state);
+    //! set urgent_ and update the flags of the tag
+    void updateUrgentAttribute(bool state);
 
     void clear_properties();
     bool ignore_unmapnotify();
 
 private:
+    void unmapWindows();
     std::string triggerRelayoutMonitor();
     friend Decoration;
     ClientManager& manager;
@@ -116,8 +135,6 @@ private:
 
 
 
-void clientlist_init();
-void clientlist_destroy();
 
 
 void reset_client_colors();
@@ -143,6 +143,8 @@ Client* ClientManager::manage_client(Window win, bool visible_already) {
     if (!changes.manage) {
         // map it... just to be sure
         XMapWindow(g_display, win);
+        // the client does not count for the tag flags
+        client->setTag(nullptr);
         return {}; // client gets destroyed
     }
 
@@ -169,7 +171,6 @@ Client* ClientManager::manage_client(Window win, bool visible_already) {
     }
 
     ewmh_window_update_tag(client->window_, client->tag());
-    tag_set_flags_dirty();
     client->set_fullscreen(changes.fullscreen);
     ewmh_update_window_state(client);
     // add client after setting the correct tag for the new client
@@ -234,7 +235,7 @@ void ClientManager::force_unmanage(Client* client) {
     tag_update_focus_layer(tag);
     needsRelayout.emit(tag);
     ewmh_remove_client(client->window_);
-    tag_set_flags_dirty();
+    client->setTag(nullptr);
     // delete client
     this->remove(client->window_);
     delete client;
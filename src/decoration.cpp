@@ -2,17 +2,73 @@
 
 #include <X11/Xlib.h>
 #include <X11/Xutil.h>
+#include <algorithm>
+#include <functional>
+#include <map>
+#include <tuple>
 
 #include "client.h"
 #include "ewmh.h"
 #include "globals.h"
 #include "settings.h"
+#include "tag.h"
 
+using std::function;
+using std::make_pair;
+using std::pair;
 using std::string;
 using std::vector;
 
 std::map<Window,Client*> Decoration::decwin2client;
 
+/* The pixmaps of decorations with the same size and look are shared.
+ * They are refcounted and freed as soon as no decoration uses them anymore.
+ */
+class DecorationPixmapCache {
+public:
+    // outer width and height, depth, border pixel, inner width and pixel,
+    // outer width and pixel, background pixel, inner rect and actual client
+    // rect relative to the outline
+    using Key = std::tuple<int, int, unsigned, unsigned long,
+                           int, unsigned long, int, unsigned long, unsigned long,
+                           int, int, int, int, int, int, int, int>;
+
+    //! return the pixmap for the key, which is created on the drawable's
+    //! screen and painted by draw if it does not exist yet
+    Pixmap acquire(const Key& key, Drawable drawable, function<void(Pixmap)> draw) {
+        auto it = entries_.find(key);
+        if (it != entries_.end()) {
+            it->second.second++;
+            return it->second.first;
+        }
+        Pixmap pix = XCreatePixmap(g_display, drawable,
+                                   std::get<0>(key), std::get<1>(key),
+                                   std::get<2>(key));
+        draw(pix);
+        entries_[key] = make_pair(pix, 1u);
+        keys_[pix] = key;
+        return pix;
+    }
+    //! drop a reference to a pixmap returned by acquire()
+    void release(Pixmap pix) {
+        auto key = keys_.find(pix);
+        if (key == keys_.end()) {
+            return;
+        }
+        auto it = entries_.find(key->second);
+        if (--it->second.second == 0) {
+            XFreePixmap(g_display, pix);
+            entries_.erase(it);
+            keys_.erase(key);
+        }
+    }
+private:
+    std::map<Key, pair<Pixmap, unsigned>> entries_; // pixmap and refcount
+    std::map<Pixmap, Key> keys_;
+};
+
+static DecorationPixmapCache g_decoration_pixmaps;
+
 Theme::Theme() {
     // add sub-decorations array as children
     vector<string> type_names = {
@@ -128,7 +184,8 @@ void Decoration::createWindow() {
     dec->depth = visual
                  ? 32
                  : (DefaultDepth(g_display, DefaultScreen(g_display)));
-    dec->decwin = XCreateWindow(g_display, g_root, 0,0, 30, 30, 0,
+    Window parent = client_->tag() ? client_->tag()->decorationParent() : g_root;
+    dec->decwin = XCreateWindow(g_display, parent, 0,0, 30, 30, 0,
                         dec->depth,
                         InputOutput,
                         visual
@@ -175,7 +232,7 @@ Decoration::~Decoration() {
         XFreeColormap(g_display, colormap);
     }
     if (pixmap) {
-        XFreePixmap(g_display, pixmap);
+        g_decoration_pixmaps.release(pixmap);
     }
     if (bgwin) {
         XDestroyWindow(g_display, bgwin);
@@ -265,39 +322,54 @@ void Decoration::resize_outline(Rectangle outline, const DecorationScheme& schem
     // update structs
     bool size_changed = outline.width != client_->dec.last_outer_rect.width
                      || outline.height != client_->dec.last_outer_rect.height;
+    bool scheme_changed = client_->dec.last_scheme != &scheme;
     client_->dec.last_outer_rect = outline;
     client_->dec.last_rect_inner = false;
     client_->last_size_ = inner;
     client_->dec.last_scheme = &scheme;
+    if (client_->dragged_ && !settings_.update_dragged_clients()) {
+        // while dragging, only move the decoration window and postpone
+        // the repaint until the drag settles, see redraw()
+        if (size_changed || scheme_changed) {
+            redraw_pending = true;
+        }
+        XMoveResizeWindow(g_display, decwin,
+                          outline.x, outline.y, outline.width, outline.height);
+        return;
+    }
+    redraw_pending = false;
     // redraw
     // TODO: reduce flickering
-    if (!client_->dragged_ || settings_.update_dragged_clients()) {
-        client_->dec.last_actual_rect.x = changes.x;
-        client_->dec.last_actual_rect.y = changes.y;
-        client_->dec.last_actual_rect.width = changes.width;
-        client_->dec.last_actual_rect.height = changes.height;
-    }
-    redrawPixmap();
-    XSetWindowBackgroundPixmap(g_display, decwin, client_->dec.pixmap);
-    if (!size_changed) {
+    client_->dec.last_actual_rect.x = changes.x;
+    client_->dec.last_actual_rect.y = changes.y;
+    client_->dec.last_actual_rect.width = changes.width;
+    client_->dec.last_actual_rect.height = changes.height;
+    if (updateBackground() && !size_changed) {
         // if size changes, then the window is cleared automatically
         XClearWindow(g_display, decwin);
     }
-    if (!client_->dragged_ || settings_.update_dragged_clients()) {
-        XConfigureWindow(g_display, win, mask, &changes);
-        XMoveResizeWindow(g_display, client_->dec.bgwin,
-                          changes.x, changes.y,
-                          changes.width, changes.height);
-    }
+    XConfigureWindow(g_display, win, mask, &changes);
+    XMoveResizeWindow(g_display, client_->dec.bgwin,
+                      changes.x, changes.y,
+                      changes.width, changes.height);
     XMoveResizeWindow(g_display, decwin,
                       outline.x, outline.y, outline.width, outline.height);
     updateFrameExtends();
-    if (!client_->dragged_ || settings_.update_dragged_clients()) {
-        client_->send_configure();
-    }
+    client_->send_configure();
     XSync(g_display, False);
 }
 
+void Decoration::redraw() {
+    if (!redraw_pending || !last_scheme) {
+        return;
+    }
+    redraw_pending = false;
+    if (updateBackground()) {
+        XClearWindow(g_display, decwin);
+    }
+    updateFrameExtends();
+}
+
 void Decoration::updateFrameExtends() {
     int left = last_inner_rect.x - last_outer_rect.x;
     int top  = last_inner_rect.y - last_outer_rect.y;
@@ -331,76 +403,107 @@ unsigned int Decoration::get_client_color(Color color) {
     }
 }
 
-// draw a decoration to the client->dec.pixmap
-void Decoration::redrawPixmap() {
+// set the decoration window's background for the current geometry and scheme
+// and return whether it changed
+bool Decoration::updateBackground() {
     const DecorationScheme& s = *last_scheme;
-    auto dec = this;
-    auto outer = client_->dec.last_outer_rect;
-    // TODO: maybe do something like pixmap recreate threshhold?
-    bool recreate_pixmap = (dec->pixmap == 0) || (dec->pixmap_width != outer.width)
-                                              || (dec->pixmap_height != outer.height);
-    if (recreate_pixmap) {
-        if (dec->pixmap) {
-            XFreePixmap(g_display, dec->pixmap);
-        }
-        dec->pixmap = XCreatePixmap(g_display, decwin, outer.width, outer.height, depth);
-    }
-    Pixmap pix = dec->pixmap;
-    GC gc = XCreateGC(g_display, pix, 0, nullptr);
-
-    // draw background
-    XSetForeground(g_display, gc, get_client_color(s.border_color()));
-    XFillRectangle(g_display, pix, gc, 0, 0, outer.width, outer.height);
-
-    // Draw inner border
+    auto outer = last_outer_rect;
+    auto inner = last_inner_rect;
+    inner.x -= outer.x;
+    inner.y -= outer.y;
     unsigned short iw = s.inner_width();
-    auto inner = client_->dec.last_inner_rect;
-    inner.x -= client_->dec.last_outer_rect.x;
-    inner.y -= client_->dec.last_outer_rect.y;
-    if (iw > 0) {
-        /* fill rectangles because drawing does not work */
-        vector<XRectangle> rects{
-            { (short)(inner.x - iw), (short)(inner.y - iw), (unsigned short)(inner.width + 2*iw), iw }, /* top */
-            { (short)(inner.x - iw), (short)(inner.y), iw, (unsigned short)(inner.height) },  /* left */
-            { (short)(inner.x + inner.width), (short)(inner.y), iw, (unsigned short)(inner.height) }, /* right */
-            { (short)(inner.x - iw), (short)(inner.y + inner.height), (unsigned short)(inner.width + 2*iw), iw }, /* bottom */
-        };
-        XSetForeground(g_display, gc, get_client_color(s.inner_color()));
-        XFillRectangles(g_display, pix, gc, &rects.front(), rects.size());
-    }
-
-    // Draw outer border
     unsigned short ow = s.outer_width;
-    outer.x -= client_->dec.last_outer_rect.x;
-    outer.y -= client_->dec.last_outer_rect.y;
-    if (ow > 0) {
-        ow = std::min((int)ow, (outer.height+1) / 2);
-        vector<XRectangle> rects{
-            { 0, 0, (unsigned short)(outer.width), ow }, /* top */
-            { 0, (short)ow, ow, (unsigned short)(outer.height - 2*ow) }, /* left */
-            { (short)(outer.width - ow), (short)ow, ow, (unsigned short)(outer.height - 2*ow) }, /* right */
-            { 0, (short)(outer.height - ow), (unsigned short)(outer.width), ow }, /* bottom */
-        };
-        XSetForeground(g_display, gc, get_client_color(s.outer_color));
-        XFillRectangles(g_display, pix, gc, &rects.front(), rects.size());
+    ow = std::min((int)ow, (outer.height+1) / 2);
+    unsigned long border_pixel = get_client_color(s.border_color());
+    unsigned long inner_pixel = iw ? get_client_color(s.inner_color()) : 0;
+    unsigned long outer_pixel = ow ? get_client_color(s.outer_color) : 0;
+    unsigned long bg_pixel = get_client_color(s.background_color);
+    auto actual = last_actual_rect;
+    bool uniform = (iw == 0 || inner_pixel == border_pixel)
+        && (ow == 0 || outer_pixel == border_pixel)
+        && (bg_pixel == border_pixel
+            || (actual.width >= inner.width && actual.height >= inner.height));
+    if (uniform) {
+        // the decoration is a single color, so no pixmap is needed
+        bool changed = !background_valid || pixmap
+                       || background_pixel != border_pixel;
+        if (pixmap) {
+            g_decoration_pixmaps.release(pixmap);
+            pixmap = 0;
+        }
+        if (changed) {
+            XSetWindowBackground(g_display, decwin, border_pixel);
+        }
+        background_pixel = border_pixel;
+        background_valid = true;
+        return changed;
     }
-    // fill inner rect that is not covered by the client
-    XSetForeground(g_display, gc, get_client_color(s.background_color));
-    if (dec->last_actual_rect.width < inner.width) {
-        XFillRectangle(g_display, pix, gc,
-                       dec->last_actual_rect.x + dec->last_actual_rect.width,
-                       dec->last_actual_rect.y,
-                       inner.width - dec->last_actual_rect.width,
-                       dec->last_actual_rect.height);
+    DecorationPixmapCache::Key key {
+        outer.width, outer.height, depth,
+        border_pixel, iw, inner_pixel, ow, outer_pixel, bg_pixel,
+        inner.x, inner.y, inner.width, inner.height,
+        actual.x, actual.y, actual.width, actual.height,
+    };
+    auto draw = [&](Pixmap pix) {
+        GC gc = XCreateGC(g_display, pix, 0, nullptr);
+
+        // draw background
+        XSetForeground(g_display, gc, border_pixel);
+        XFillRectangle(g_display, pix, gc, 0, 0, outer.width, outer.height);
+
+        // Draw inner border
+        if (iw > 0) {
+            /* fill rectangles because drawing does not work */
+            vector<XRectangle> rects{
+                { (short)(inner.x - iw), (short)(inner.y - iw), (unsigned short)(inner.width + 2*iw), iw }, /* top */
+                { (short)(inner.x - iw), (short)(inner.y), iw, (unsigned short)(inner.height) },  /* left */
+                { (short)(inner.x + inner.width), (short)(inner.y), iw, (unsigned short)(inner.height) }, /* right */
+                { (short)(inner.x - iw), (short)(inner.y + inner.height), (unsigned short)(inner.width + 2*iw), iw }, /* bottom */
+            };
+            XSetForeground(g_display, gc, inner_pixel);
+            XFillRectangles(g_display, pix, gc, &rects.front(), rects.size());
+        }
+
+        // Draw outer border
+        if (ow > 0) {
+            vector<XRectangle> rects{
+                { 0, 0, (unsigned short)(outer.width), ow }, /* top */
+                { 0, (short)ow, ow, (unsigned short)(outer.height - 2*ow) }, /* left */
+                { (short)(outer.width - ow), (short)ow, ow, (unsigned short)(outer.height - 2*ow) }, /* right */
+                { 0, (short)(outer.height - ow), (unsigned short)(outer.width), ow }, /* bottom */
+            };
+            XSetForeground(g_display, gc, outer_pixel);
+            XFillRectangles(g_display, pix, gc, &rects.front(), rects.size());
+        }
+        // fill inner rect that is not covered by the client
+        XSetForeground(g_display, gc, bg_pixel);
+        if (actual.width < inner.width) {
+            XFillRectangle(g_display, pix, gc,
+                           actual.x + actual.width,
+                           actual.y,
+                           inner.width - actual.width,
+                           actual.height);
+        }
+        if (actual.height < inner.height) {
+            XFillRectangle(g_display, pix, gc,
+                           actual.x,
+                           actual.y + actual.height,
+                           inner.width,
+                           inner.height - actual.height);
+        }
+        // clean up
+        XFreeGC(g_display, gc);
+    };
+    // acquire the new pixmap first, such that an unchanged pixmap is kept
+    Pixmap pix = g_decoration_pixmaps.acquire(key, decwin, draw);
+    if (pixmap) {
+        g_decoration_pixmaps.release(pixmap);
     }
-    if (dec->last_actual_rect.height < inner.height) {
-        XFillRectangle(g_display, pix, gc,
-                       dec->last_actual_rect.x,
-                       dec->last_actual_rect.y + dec->last_actual_rect.height,
-                       inner.width,
-                       inner.height - dec->last_actual_rect.height);
+    bool changed = !background_valid || pix != pixmap;
+    pixmap = pix;
+    if (changed) {
+        XSetWindowBackgroundPixmap(g_display, decwin, pixmap);
     }
-    // clean up
-    XFreeGC(g_display, gc);
+    background_valid = true;
+    return changed;
 }
-
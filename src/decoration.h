@@ -50,6 +50,8 @@ public:
     // resize such that the window content fits into rect
     void resize_inner(Rectangle rect, const DecorationScheme& scheme);
     void change_scheme(const DecorationScheme& scheme);
+    // repaint the decoration if this was postponed while being dragged
+    void redraw();
 
     static Client* toClient(Window decoration_window);
 
@@ -57,9 +59,11 @@ public:
     Rectangle last_inner() const { return last_inner_rect; }
     Rectangle last_outer() const { return last_outer_rect; }
     Rectangle inner_to_outer(Rectangle rect);
+    //! whether the window has an alpha channel and may show what is below
+    bool hasAlpha() const { return depth == 32; }
 
 private:
-    void redrawPixmap();
+    bool updateBackground();
     void updateFrameExtends();
     unsigned int get_client_color(Color color);
 
@@ -69,12 +73,13 @@ private:
     Rectangle   last_inner_rect; // only valid if width >= 0
     Rectangle   last_outer_rect; // only valid if width >= 0
     Rectangle   last_actual_rect; // last actual client rect, relative to decoration
+    bool        redraw_pending = false; // whether the pixmap is outdated
     /* X specific things */
     Colormap                colormap;
     unsigned int            depth;
-    Pixmap                  pixmap = 0;
-    int                     pixmap_height = 0;
-    int                     pixmap_width = 0;
+    Pixmap                  pixmap = 0; // shared with equal decorations
+    unsigned long           background_pixel = 0; // if there is no pixmap
+    bool                    background_valid = false; // if it has been set
     // fill the area behind client with another window that does nothing,
     // especially not repainting or background filling to avoid flicker on
     // unmap
@@ -7,6 +7,7 @@
 #include <cstring>
 #include <limits>
 
+#include "atoms.h"
 #include "client.h"
 #include "globals.h"
 #include "layout.h"
@@ -27,8 +28,6 @@ Atom g_netatom[NetCOUNT];
 static vector<Window> g_windows; // array with Window-IDs in initial mapping order
 static Window      g_wm_window;
 
-static int WM_STATE;
-
 static Window*  g_original_clients = nullptr;
 static unsigned long g_original_clients_count = 0;
 static bool ewmh_read_client_list(Window** buf, unsigned long *count);
@@ -74,15 +73,7 @@ const std::array<const char*,NetCOUNT>g_netatom_names =
 }).a;
 
 void ewmh_init() {
-    /* init ewmh net atoms */
-    for (int i = 0; i < NetCOUNT; i++) {
-        if (!g_netatom_names[i]) {
-            HSWarning("no name specified in g_netatom_names "
-                      "for atom number %d\n", i);
-            continue;
-        }
-        g_netatom[i] = XInternAtom(g_display, g_netatom_names[i], False);
-    }
+    /* the ewmh net atoms already have been interned by atoms_init() */
 
     /* tell which ewmh atoms are supported */
     XChangeProperty(g_display, g_root, g_netatom[NetSupported], XA_ATOM, 32,
@@ -95,9 +86,6 @@ void ewmh_init() {
         g_original_clients_count = 0;
     }
 
-    /* init other atoms */
-    WM_STATE = XInternAtom(g_display, "WM_STATE", False);
-
     /* init for the supporting wm check */
     g_wm_window = XCreateSimpleWindow(g_display, g_root,
                                       42, 42, 42, 42, 0, 0, 0);
@@ -132,10 +120,10 @@ void ewmh_destroy() {
 
 void ewmh_set_wmname(const char* name) {
     XChangeProperty(g_display, g_wm_window, g_netatom[NetWmName],
-        ATOM("UTF8_STRING"), 8, PropModeReplace,
+        g_atom[AtomUtf8String], 8, PropModeReplace,
         (unsigned char*)name, strlen(name));
     XChangeProperty(g_display, g_root, g_netatom[NetWmName],
-        ATOM("UTF8_STRING"), 8, PropModeReplace,
+        g_atom[AtomUtf8String], 8, PropModeReplace,
         (unsigned char*)name, strlen(name));
 }
 
@@ -459,7 +447,7 @@ void ewmh_update_frame_extents(Window win, int left, int right, int top, int bot
 
 void window_update_wm_state(Window win, WmState state) {
     uint32_t int_state = state;
-    XChangeProperty(g_display, win,  WM_STATE, XA_CARDINAL,
+    XChangeProperty(g_display, win, g_atom[AtomWmState], XA_CARDINAL,
                     32, PropModeReplace, (unsigned char*)&int_state, 1);
 }
 
@@ -1,6 +1,5 @@
 #include "floating.h"
 
-#include <algorithm>
 #include <climits>
 #include <cstdlib>
 
@@ -15,55 +14,46 @@
 using std::vector;
 using std::make_pair;
 
-// rectlist_rotate rotates the list of given rectangles, s.t. the direction dir
-// becomes the direction "right". idx is some distinguished element, whose
-// index may change
-static void rectlist_rotate(RectangleIdxVec& rects, int& idx, Direction dir) {
-    // Note: For DirRight, there is nothing to do.
-
-    if (dir == Direction::Up) {
-        // just flip by the horizontal axis
-        for (auto& r : rects) {
-            r.second.y = - r.second.y - r.second.height;
-        }
-        // and flip order to reverse the order for rectangles with the same
-        // center
-        reverse(rects.begin(), rects.end());
-        idx = rects.size() - 1 - idx;
-        // and then direction up now has become direction down
-    }
-
-    if (dir == Direction::Up || dir == Direction::Down) {
-        // flip by the diagonal
-        //
-        //   *-------------> x     *-------------> x
-        //   |   +------+          |   +---+[]
-        //   |   |      |     ==>  |   |   |
-        //   |   +------+          |   |   |
-        //   |   []                |   +---+
-        //   V                     V
-        for (auto& r : rects) {
-            SWAP(int, r.second.x, r.second.y);
-            SWAP(int, r.second.height, r.second.width);
-        }
-    }
-
-    if (dir == Direction::Left) {
-        // flip by the vertical axis
-        for (auto& r : rects) {
-            r.second.x = - r.second.x - r.second.width;
-        }
-        // and flip order to reverse the order for rectangles with the same
-        // center
-        reverse(rects.begin(), rects.end());
-        idx = rects.size() - 1 - idx;
+// rect_rotate returns the given rectangle in a rotated coordinate system in
+// which the direction dir becomes the direction "right".
+static Rectangle rect_rotate(Rectangle r, Direction dir) {
+    switch (dir) {
+        case Direction::Right:
+            break;
+        case Direction::Left:
+            // flip by the vertical axis
+            r.x = - r.x - r.width;
+            break;
+        case Direction::Up:
+            // flip by the horizontal axis, then direction up has become
+            // direction down
+            r.y = - r.y - r.height;
+            // fall through
+        case Direction::Down:
+            // flip by the diagonal
+            //
+            //   *-------------> x     *-------------> x
+            //   |   +------+          |   +---+[]
+            //   |   |      |     ==>  |   |   |
+            //   |   +------+          |   |   |
+            //   |   []                |   +---+
+            //   V                     V
+            SWAP(int, r.x, r.y);
+            SWAP(int, r.width, r.height);
+            break;
     }
+    return r;
 }
 
-// returns the found index in the original buffer
-int find_rectangle_in_direction(RectangleIdxVec& rects, int idx, Direction dir) {
-    rectlist_rotate(rects, idx, dir);
-    return find_rectangle_right_of(rects, idx);
+// rect_rank gives the position of the i'th of count rectangles when breaking
+// ties between rectangles. For the directions left and up, the order is
+// reversed like the coordinates, such that rectangles with the same center
+// are visited in the opposite order.
+static int rect_rank(int i, int count, Direction dir) {
+    if (dir == Direction::Left || dir == Direction::Up) {
+        return count - 1 - i;
+    }
+    return i;
 }
 
 static bool rectangle_is_right_of(Rectangle RC, Rectangle R2) {
@@ -94,76 +84,53 @@ static bool rectangle_is_right_of(Rectangle RC, Rectangle R2) {
     return true;
 }
 
-int find_rectangle_right_of(RectangleIdxVec rects, int idx) {
-    auto RC = rects[idx].second;
+// returns the id (the first entry of the pair) of the found rectangle
+int find_rectangle_in_direction(const RectangleIdxVec& rects, int idx, Direction dir) {
+    int count = rects.size();
+    auto RC = rect_rotate(rects[idx].second, dir);
     int cx = RC.x + RC.width / 2;
     int cy = RC.y + RC.height / 2;
-    int write_i = 0; // next rectangle to write
-    // filter out rectangles not right of RC
-    FOR (i,0,rects.size()) {
+    int rankidx = rect_rank(idx, count, dir);
+    // find the rectangle right of RC with the smallest distance to RC
+    int idxbest = -1;
+    int rankbest = INT_MAX;
+    int distbest = INT_MAX;
+    FOR (i,0,count) {
         if (idx == i) continue;
-        auto R2 = rects[i].second;
+        auto R2 = rect_rotate(rects[i].second, dir);
+        if (!rectangle_is_right_of(RC, R2)) continue;
+        int rank = rect_rank(i, count, dir);
         int rcx = R2.x + R2.width / 2;
         int rcy = R2.y + R2.height / 2;
-        if (!rectangle_is_right_of(RC, R2)) continue;
         // if two rectangles have exactly the same geometry, then sort by index
         // compare centers and not topleft corner because rectangle_is_right_of
         // does it the same way
         if (rcx == cx && rcy == cy) {
-            if (i < idx) continue;
+            if (rank < rankidx) continue;
         }
-        if (i == write_i) { write_i++; }
-        else {
-            rects[write_i++] = rects[i];
-        }
-    }
-    // find the rectangle with the smallest distance to RC
-    if (write_i == 0) return -1;
-    int idxbest = -1;
-    int ibest = -1;
-    int distbest = INT_MAX;
-    FOR (i,0,write_i) {
-        auto R2 = rects[i].second;
-        int rcx = R2.x + R2.width / 2;
-        int rcy = R2.y + R2.height / 2;
                             // another method that checks the closes point
         int anchor_y = rcy; // (rcy > cy) ? rcy : std::min(rcy + R2.height, cy);
         int anchor_x = rcx; // std::max(cx, R2.x);
         // get manhatten distance to the anchor
         int dist = abs(anchor_x - cx) + abs(anchor_y - cy);
         if (dist < distbest
-            || (dist == distbest && ibest > i)) {
+            || (dist == distbest && rank < rankbest)) {
             distbest = dist;
             idxbest = rects[i].first;
-            ibest = i;
+            rankbest = rank;
         }
     }
     return idxbest;
 }
 
-// returns the found index in the modified buffer
-int find_edge_in_direction(RectangleIdxVec& rects, int idx, Direction dir)
+// returns the position of the found rectangle in rects
+int find_edge_in_direction(const RectangleIdxVec& rects, int idx, Direction dir)
 {
-    rectlist_rotate(rects, idx, dir);
-    int found = find_edge_right_of(rects, idx);
-    if (found < 0) return found;
-    // rotate back, by requesting the inverse rotation
-    //switch (dir) {
-    //    case DirLeft: break; // DirLeft is inverse to itself
-    //    case DirRight: break; // DirRight is the identity
-    //    case DirUp: dir = DirDown; break; // once was rotated 90 deg counterclockwise..
-    //                                      // now has to be rotate 90 deg clockwise back
-    //    case DirDown: dir = DirUp; break;
-    //}
-    rectlist_rotate(rects, found, dir);
-    rectlist_rotate(rects, found, dir);
-    rectlist_rotate(rects, found, dir);
-    return found;
-}
-int find_edge_right_of(RectangleIdxVec rects, int idx) {
-    int xbound = rects[idx].second.x + rects[idx].second.width;
-    int ylow = rects[idx].second.y;
-    int yhigh = rects[idx].second.y + rects[idx].second.height;
+    int count = rects.size();
+    auto RC = rect_rotate(rects[idx].second, dir);
+    int xbound = RC.x + RC.width;
+    int ylow = RC.y;
+    int yhigh = RC.y + RC.height;
     // only keep rectangles with a x coordinate right of the xbound
     // and with an appropriate y/height
     //
@@ -171,18 +138,23 @@ int find_edge_right_of(RectangleIdxVec rects, int idx) {
     //      |   idx   |   area of intrest
     //      +---------+ - - - - - - - - - - -
     int leftmost = -1;
+    int rankbest = INT_MAX;
     int dist = INT_MAX;
-    FOR (i,0,rects.size()) {
+    FOR (i,0,count) {
         if (i == idx) continue;
-        if (rects[i].second.x <= xbound) continue;
-        int low = rects[i].second.y;
-        int high = low + rects[i].second.height;
+        auto R2 = rect_rotate(rects[i].second, dir);
+        if (R2.x <= xbound) continue;
+        int low = R2.y;
+        int high = low + R2.height;
         if (!intervals_intersect(ylow, yhigh, low, high)) {
             continue;
         }
-        if (rects[i].second.x - xbound < dist) {
-            dist = rects[i].second.x - xbound;
+        int rank = rect_rank(i, count, dir);
+        if (R2.x - xbound < dist
+            || (R2.x - xbound == dist && rank < rankbest)) {
+            dist = R2.x - xbound;
             leftmost = i;
+            rankbest = rank;
         }
     }
     return leftmost;
@@ -9,10 +9,8 @@ void floating_destroy();
 
 // utilities
 int char_to_direction(char ch);
-int find_rectangle_in_direction(RectangleIdxVec& rects, int idx, Direction dir);
-int find_rectangle_right_of(RectangleIdxVec rects, int idx);
-int find_edge_in_direction(RectangleIdxVec& rects, int idx, Direction dir);
-int find_edge_right_of(RectangleIdxVec rects, int idx);
+int find_rectangle_in_direction(const RectangleIdxVec& rects, int idx, Direction dir);
+int find_edge_in_direction(const RectangleIdxVec& rects, int idx, Direction dir);
 
 // actual implementations
 bool floating_focus_direction(Direction dir);
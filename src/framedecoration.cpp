@@ -28,9 +28,10 @@ FrameDecoration::FrameDecoration(HSTag* tag_, Settings* settings_)
          |ExposureMask|VisibilityChangeMask
          |EnterWindowMask|LeaveWindowMask|FocusChangeMask;
 
-    window = XCreateWindow(g_display, g_root,
+    depth = DefaultDepth(g_display, DefaultScreen(g_display));
+    window = XCreateWindow(g_display, tag->decorationParent(),
                         42, 42, 42, 42, settings->frame_border_width(),
-                        DefaultDepth(g_display, DefaultScreen(g_display)),
+                        depth,
                         CopyFromParent,
                         DefaultVisual(g_display, DefaultScreen(g_display)),
                         CWOverrideRedirect | CWBackPixmap | CWEventMask, &at);
@@ -55,48 +56,92 @@ FrameDecoration::~FrameDecoration() {
 }
 
 void FrameDecoration::render(const FrameDecorationData& data, bool isFocused) {
-    unsigned long border_color = settings->frame_border_normal_color->toX11Pixel();
-    unsigned long bg_color = settings->frame_bg_normal_color->toX11Pixel();
-    int bw = settings->frame_border_width();
+    RenderState next;
+    next.valid = true;
+    next.geometry = data.geometry;
+    next.borderColor = settings->frame_border_normal_color->toX11Pixel();
+    next.bgColor = settings->frame_bg_normal_color->toX11Pixel();
+    next.borderWidth = settings->frame_border_width();
+    next.opacity = settings->frame_normal_opacity();
     if (isFocused) {
-        border_color = settings->frame_border_active_color->toX11Pixel();
-        bg_color = settings->frame_bg_active_color->toX11Pixel();
+        next.borderColor = settings->frame_border_active_color->toX11Pixel();
+        next.bgColor = settings->frame_bg_active_color->toX11Pixel();
+        next.opacity = settings->frame_active_opacity();
     }
     if (settings->smart_frame_surroundings() && !data.hasParent) {
-        bw = 0;
+        next.borderWidth = 0;
     }
-    Rectangle rect = data.geometry;
-    XSetWindowBorderWidth(g_display, window, bw);
-    XMoveResizeWindow(g_display, window,
-                      rect.x - bw,
-                      rect.y - bw,
-                      rect.width, rect.height);
-
     if (settings->frame_border_inner_width() > 0
         && settings->frame_border_inner_width() < settings->frame_border_width()) {
-        set_window_double_border(g_display, window,
-                settings->frame_border_inner_width(),
-                settings->frame_border_inner_color->toX11Pixel(),
-                border_color);
-    } else {
-        XSetWindowBorder(g_display, window, border_color);
+        next.innerWidth = settings->frame_border_inner_width();
+        next.innerColor = settings->frame_border_inner_color->toX11Pixel();
+    }
+    bool transparent = settings->frame_bg_transparent();
+    next.transparentWidth = settings->frame_transparent_width();
+
+    const RenderState& prev = rendered;
+    bool force = !prev.valid;
+    Rectangle rect = next.geometry;
+    bool bwChanged = force || next.borderWidth != prev.borderWidth;
+    bool sizeChanged = force
+        || rect.width != prev.geometry.width
+        || rect.height != prev.geometry.height;
+    bool posChanged = force
+        || rect.x != prev.geometry.x
+        || rect.y != prev.geometry.y;
+
+    if (bwChanged) {
+        XSetWindowBorderWidth(g_display, window, next.borderWidth);
+    }
+    if (bwChanged || sizeChanged || posChanged) {
+        XMoveResizeWindow(g_display, window,
+                          rect.x - next.borderWidth,
+                          rect.y - next.borderWidth,
+                          rect.width, rect.height);
+    }
+
+    if (next.innerWidth > 0) {
+        // the border pixmap depends on the window size
+        if (bwChanged || sizeChanged
+            || next.innerWidth != prev.innerWidth
+            || next.innerColor != prev.innerColor
+            || next.borderColor != prev.borderColor)
+        {
+            set_window_double_border(g_display, window,
+                                     rect.width, rect.height,
+                                     next.borderWidth, depth,
+                                     next.innerWidth,
+                                     next.innerColor, next.borderColor);
+        }
+    } else if (force || prev.innerWidth > 0
+               || next.borderColor != prev.borderColor) {
+        XSetWindowBorder(g_display, window, next.borderColor);
     }
 
-    XSetWindowBackground(g_display, window, bg_color);
-    if (settings->frame_bg_transparent()) {
-        window_cut_rect_hole(window, rect.width, rect.height,
-                             settings->frame_transparent_width());
+    bool bgChanged = force || next.bgColor != prev.bgColor;
+    if (bgChanged) {
+        XSetWindowBackground(g_display, window, next.bgColor);
+    }
+    if (transparent) {
+        if (!window_transparent || sizeChanged
+            || next.transparentWidth != prev.transparentWidth) {
+            window_cut_rect_hole(window, rect.width, rect.height,
+                                 next.transparentWidth);
+        }
     } else if (window_transparent) {
-        window_make_intransparent(window, rect.width, rect.height);
+        window_make_intransparent(window);
     }
-    window_transparent = settings->frame_bg_transparent();
-    if (isFocused) {
-        ewmh_set_window_opacity(window, settings->frame_active_opacity()/100.0);
-    } else {
-        ewmh_set_window_opacity(window, settings->frame_normal_opacity()/100.0);
+    window_transparent = transparent;
+    if (force || next.opacity != prev.opacity) {
+        ewmh_set_window_opacity(window, next.opacity/100.0);
     }
 
-    XClearWindow(g_display, window);
+    if (bgChanged) {
+        // on all other changes, the X server repaints the affected
+        // areas itself
+        XClearWindow(g_display, window);
+    }
+    rendered = next;
 }
 
 void FrameDecoration::updateVisibility(const FrameDecorationData& data, bool isFocused)
@@ -110,6 +155,15 @@ void FrameDecoration::updateVisibility(const FrameDecorationData& data, bool isF
     }
 }
 
+void FrameDecoration::setParent(Window parent) {
+    int x = 0, y = 0;
+    if (rendered.valid) {
+        x = rendered.geometry.x - rendered.borderWidth;
+        y = rendered.geometry.y - rendered.borderWidth;
+    }
+    XReparentWindow(g_display, window, parent, x, y);
+}
+
 void FrameDecoration::hide() {
     if (visible) {
         visible = false;
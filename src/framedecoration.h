@@ -25,11 +25,30 @@ public:
     void render(const FrameDecorationData& data, bool isFocused);
     void updateVisibility(const FrameDecorationData& data, bool isFocused);
     void hide();
+    //! move the window to the given parent, keeping its position on screen
+    void setParent(Window parent);
 
 private:
+    // the inputs of the last render() call, used to only send those
+    // requests to the X server whose inputs have changed
+    class RenderState {
+    public:
+        bool valid = false; // whether anything has been rendered yet
+        Rectangle geometry;
+        int borderWidth = 0;
+        unsigned long borderColor = 0;
+        int innerWidth = 0; // 0 if there is no double border
+        unsigned long innerColor = 0;
+        unsigned long bgColor = 0;
+        int transparentWidth = 0;
+        int opacity = 100;
+    };
+
     Window window;
+    unsigned depth; // the depth of window
     bool visible; // whether the window is visible at the moment
     bool window_transparent; // whether the window has a mask at the moment
+    RenderState rendered;
     Slice* slice;
     HSTag* tag;
     Settings* settings;
@@ -0,0 +1,95 @@
+#include "framelayout.h"
+
+#include "globals.h"
+#include "layoutgeometry.h"
+
+static void layout_linear(Rectangle rect, bool vertical,
+                          const LeafLayout& leaf, TilingResult& res) {
+    size_t count = leaf.clients.size();
+    for (size_t i = 0; i < count; i++) {
+        res.add(leaf.clients[i],
+                TilingStep(layout_linear_cell(rect, vertical, count, i)));
+    }
+}
+
+static void layout_max(Rectangle rect, const LeafLayout& leaf,
+                       TilingResult& res) {
+    // the other clients are only hidden if the selected one covers them
+    size_t count = leaf.clients.size();
+    for (size_t i = 0; i < count; i++) {
+        TilingStep step(rect);
+        if (i == (size_t)leaf.selection) {
+            step.needsRaise = true;
+        } else {
+            step.hidden = leaf.selectionCoversTile;
+        }
+        res.add(leaf.clients[i], step);
+    }
+}
+
+static void layout_grid(Rectangle rect, bool gapless, const LeafLayout& leaf,
+                        TilingResult& res) {
+    size_t count = leaf.clients.size();
+    if (count == 0) return;
+
+    int rows, cols;
+    frame_layout_grid_get_size(count, &rows, &cols);
+    for (size_t i = 0; i < count; i++) {
+        auto cur = layout_grid_cell(rect, rows, cols, count, i, gapless);
+        res.add(leaf.clients[i], TilingStep(cur));
+    }
+}
+
+void layout_leaf_frame(Rectangle rect, const LayoutSettings& settings,
+                       const LeafLayout& leaf, TilingResult& res) {
+    bool decorated = !settings.smartFrameSurroundings || leaf.hasParent;
+    rect = layout_leaf_content(rect, decorated, settings.frameGap,
+                               settings.frameBorderWidth,
+                               WINDOW_MIN_WIDTH, WINDOW_MIN_HEIGHT);
+
+    // move windows
+    FrameDecorationData frame_data;
+    frame_data.geometry = rect;
+    frame_data.visible = true;
+    frame_data.hasClients = leaf.clients.size() > 0;
+    frame_data.hasParent = leaf.hasParent;
+    res.focused_frame = leaf.decoration;
+    res.focus = nullptr;
+    res.add(leaf.decoration, frame_data);
+    if (leaf.clients.size() == 0) {
+        return;
+    }
+
+    bool smartWindowSurroundings = settings.smartWindowSurroundings
+        && (leaf.clients.size() == 1 || leaf.layout == LAYOUT_MAX);
+    if (!smartWindowSurroundings) {
+        rect = layout_client_area(rect, settings.windowGap,
+                                  settings.framePadding);
+    }
+    if (leaf.layout == LAYOUT_MAX) {
+        layout_max(rect, leaf, res);
+    } else if (leaf.layout == LAYOUT_GRID) {
+        layout_grid(rect, settings.gaplessGrid, leaf, res);
+    } else if (leaf.layout == LAYOUT_VERTICAL) {
+        layout_linear(rect, true, leaf, res);
+    } else {
+        layout_linear(rect, false, leaf, res);
+    }
+    res.focus = leaf.clients[leaf.selection];
+}
+
+void layout_split_frame(Rectangle rect, const LayoutSettings& settings,
+                        bool vertical, int fraction, int selection,
+                        FrameLayout& first, FrameLayout& second,
+                        TilingResult& res) {
+    auto children = layout_split(rect, vertical, fraction);
+    first.computeLayout(children.first, settings, res);
+    // the children overwrite the focus, so remember the one of the first
+    auto first_focus = res.focus;
+    auto first_focused_frame = res.focused_frame;
+    second.computeLayout(children.second, settings, res);
+    if (selection == 0) {
+        res.focus = first_focus;
+        res.focused_frame = first_focused_frame;
+    }
+}
@@ -0,0 +1,77 @@
+#ifndef __HERBSTLUFT_FRAMELAYOUT_H_
+#define __HERBSTLUFT_FRAMELAYOUT_H_
+
+#include <vector>
+
+#include "tilingresult.h"
+#include "x11-types.h"
+
+/* The layout computation of the frame tree. It sees the frame tree only
+ * through the FrameLayout interface and gets the values of the settings
+ * passed, so it is part of hlwm_layout and the layout benchmark runs the
+ * same code as herbstluftwm, without an X server.
+ */
+
+enum {
+    ALIGN_VERTICAL = 0,
+    ALIGN_HORIZONTAL,
+    // temporary values in split_command
+    ALIGN_EXPLODE,
+};
+
+enum {
+    LAYOUT_VERTICAL = 0,
+    LAYOUT_HORIZONTAL,
+    LAYOUT_MAX,
+    LAYOUT_GRID,
+    LAYOUT_COUNT,
+};
+
+class Client;
+class FrameDecoration;
+
+//! the values of the settings that affect the layout
+class LayoutSettings {
+public:
+    int frameGap = 0;
+    int frameBorderWidth = 0;
+    int windowGap = 0;
+    int framePadding = 0;
+    bool gaplessGrid = false;
+    bool smartFrameSurroundings = false;
+    bool smartWindowSurroundings = false;
+};
+
+//! a node of the frame tree as seen by the layout computation
+class FrameLayout {
+public:
+    virtual ~FrameLayout() = default;
+    //! append the layout of this subtree within rect to res
+    virtual void computeLayout(Rectangle rect, const LayoutSettings& settings,
+                               TilingResult& res) = 0;
+};
+
+//! the state of a leaf frame its layout depends on. The clients are only
+//! passed through to the TilingResult and never dereferenced.
+class LeafLayout {
+public:
+    const std::vector<Client*>& clients;
+    int selection;
+    int layout;
+    bool hasParent;
+    //! whether the selected client covers the other clients in a max layout
+    bool selectionCoversTile;
+    FrameDecoration* decoration;
+};
+
+//! append the layout of a leaf frame within rect to res
+void layout_leaf_frame(Rectangle rect, const LayoutSettings& settings,
+                       const LeafLayout& leaf, TilingResult& res);
+
+//! append the layout of a split frame within rect and of its children to res
+void layout_split_frame(Rectangle rect, const LayoutSettings& settings,
+                        bool vertical, int fraction, int selection,
+                        FrameLayout& first, FrameLayout& second,
+                        TilingResult& res);
+
+#endif
@@ -13,6 +13,7 @@ using std::endl;
 using std::function;
 using std::make_shared;
 using std::shared_ptr;
+using std::static_pointer_cast;
 using std::string;
 using std::vector;
 
@@ -20,7 +21,7 @@ FrameTree::FrameTree(HSTag* tag, Settings* settings)
     : tag_(tag)
     , settings_(settings)
 {
-    root_ = make_shared<HSFrameLeaf>(tag, settings, shared_ptr<HSFrameSplit>());
+    root_ = make_shared<HSFrameLeaf>(tag, settings, nullptr);
     (void) tag_;
     (void) settings_;
 }
@@ -103,13 +104,14 @@ shared_ptr<HSFrameLeaf> FrameTree::focusedFrame() {
 /*! get the focused frame within the subtree of the given node
  */
 shared_ptr<HSFrameLeaf> FrameTree::focusedFrame(shared_ptr<HSFrame> node) {
-    while (node->isLeaf() == nullptr) {
-        // node must be a frame split
-        auto s = node->isSplit();
-        node = (s->selection_ == 0) ? s->a_ : s->b_;
+    // descend via plain pointers and only create a shared_ptr at the end
+    HSFrame* n = &* node;
+    while (HSFrameSplit* s = dynamic_cast<HSFrameSplit*>(n)) {
+        n = &* ((s->selection_ == 0) ? s->a_ : s->b_);
     }
-    assert(node->isLeaf() != nullptr);
-    return node->isLeaf();
+    HSFrameLeaf* leaf = dynamic_cast<HSFrameLeaf*>(n);
+    assert(leaf != nullptr);
+    return leaf->thisLeaf();
 }
 
 
@@ -145,7 +147,8 @@ int FrameTree::removeFrameCommand() {
         // do nothing if is toplevel frame
         return 0;
     }
-    auto parent = frame->getParent();
+    // keep the parent alive while it is replaced by its other child
+    auto parent = frame->getParent()->thisSplit();
     auto pp = parent->getParent();
     auto newparent = (frame == parent->firstChild())
                      ? parent->secondChild()
@@ -157,6 +160,7 @@ int FrameTree::removeFrameCommand() {
     } else {
         // if parent was root frame
         root_ = newparent;
+        newparent->parent_ = nullptr;
     }
     frame_focus_recursive(parent);
     get_current_monitor()->applyLayout();
@@ -262,11 +266,11 @@ shared_ptr<TreeInterface> FrameTree::treeInterface(
     };
     return frame->switchcase<shared_ptr<TreeInterface>>(
         [focus] (shared_ptr<HSFrameLeaf> l) {
-            return std::static_pointer_cast<TreeInterface>(
+            return static_pointer_cast<TreeInterface>(
                     make_shared<LeafTI>(l, focus));
         },
         [focus] (shared_ptr<HSFrameSplit> s) {
-            return std::static_pointer_cast<TreeInterface>(
+            return static_pointer_cast<TreeInterface>(
                     make_shared<SplitTI>(s, focus));
         }
     );
@@ -278,16 +282,7 @@ void FrameTree::prettyPrint(shared_ptr<HSFrame> frame, Output output) {
 }
 
 shared_ptr<HSFrameLeaf> FrameTree::findFrameWithClient(Client* client) {
-    shared_ptr<HSFrameLeaf> frame = {};
-    root_->fmap(
-        [](HSFrameSplit*) {},
-        [&](HSFrameLeaf* l) {
-            auto& cs = l->clients;
-            if (std::find(cs.begin(), cs.end(), client) != cs.end()) {
-                frame = l->thisLeaf();
-            }
-        });
-    return frame;
+    return root_->frameWithClient(client);
 }
 
 bool FrameTree::focusClient(Client* client) {
@@ -305,17 +300,18 @@ bool FrameTree::focusClient(Client* client) {
 }
 
 void FrameTree::focusFrame(shared_ptr<HSFrame> frame) {
-    while (frame) {
-        auto parent = frame->getParent();
+    HSFrame* node = frame.get();
+    while (node) {
+        auto parent = node->getParent();
         if (!parent) {
             break;
         }
-        if (parent->firstChild() == frame) {
+        if (parent->firstChild().get() == node) {
             parent->selection_ = 0;
         } else {
             parent->selection_ = 1;
         }
-        frame = parent;
+        node = parent;
     }
 }
 
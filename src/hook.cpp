@@ -8,6 +8,7 @@
 #include <cassert>
 #include <cstdio>
 
+#include "atoms.h"
 #include "globals.h"
 #include "ipc-protocol.h"
 #include "tag.h"
@@ -29,13 +30,13 @@ void hook_init() {
     // ignore all events for this window
     XSelectInput(g_display, g_event_window, 0l);
     // set its window id in root window
-    XChangeProperty(g_display, g_root, ATOM(HERBST_HOOK_WIN_ID_ATOM),
+    XChangeProperty(g_display, g_root, g_atom[AtomHerbstHookWinId],
         XA_ATOM, 32, PropModeReplace, (unsigned char*)&g_event_window, 1);
 }
 
 void hook_destroy() {
     // remove property from root window
-    XDeleteProperty(g_display, g_root, ATOM(HERBST_HOOK_WIN_ID_ATOM));
+    XDeleteProperty(g_display, g_root, g_atom[AtomHerbstHookWinId]);
     XDestroyWindow(g_display, g_event_window);
 }
 
@@ -51,9 +52,7 @@ void hook_emit(vector<string> args) {
         args_c_str.push_back(s.c_str());
     }
     XTextProperty text_prop;
-    static char atom_name[STRING_BUF_SIZE];
-    snprintf(atom_name, STRING_BUF_SIZE, HERBST_HOOK_PROPERTY_FORMAT, last_property_number);
-    Atom atom = ATOM(atom_name);
+    Atom atom = g_hook_atom[last_property_number];
     Xutf8TextListToTextProperty(g_display, (char**) args_c_str.data(), args.size(), XUTF8StringStyle, &text_prop);
     XSetTextProperty(g_display, g_event_window, &text_prop, atom);
     XFree(text_prop.value);
@@ -7,6 +7,7 @@
 #include <cstring>
 #include <sstream>
 
+#include "atoms.h"
 #include "command.h"
 #include "globals.h"
 #include "ipc-protocol.h"
@@ -23,7 +24,7 @@ void ipc_add_connection(Window window) {
 
 bool ipc_handle_connection(Window win) {
     XTextProperty text_prop;
-    if (!XGetTextProperty(g_display, win, &text_prop, ATOM(HERBST_IPC_ARGS_ATOM))) {
+    if (!XGetTextProperty(g_display, win, &text_prop, g_atom[AtomHerbstIpcArgs])) {
         // if the args atom is not present any more then it already has been
         // executed (e.g. after being called by ipc_add_connection())
         return false;
@@ -41,12 +42,12 @@ bool ipc_handle_connection(Window win) {
     int status = call_command(count, list_return, output);
     // send output back
     // Mark this command as executed
-    XDeleteProperty(g_display, win, ATOM(HERBST_IPC_ARGS_ATOM));
-    XChangeProperty(g_display, win, ATOM(HERBST_IPC_OUTPUT_ATOM),
-        ATOM("UTF8_STRING"), 8, PropModeReplace,
+    XDeleteProperty(g_display, win, g_atom[AtomHerbstIpcArgs]);
+    XChangeProperty(g_display, win, g_atom[AtomHerbstIpcOutput],
+        g_atom[AtomUtf8String], 8, PropModeReplace,
         (unsigned char*)output.str().c_str(), 1 + output.str().size());
     // and also set the exit status
-    XChangeProperty(g_display, win, ATOM(HERBST_IPC_STATUS_ATOM),
+    XChangeProperty(g_display, win, g_atom[AtomHerbstIpcStatus],
         XA_ATOM, 32, PropModeReplace, (unsigned char*)&(status), 1);
     // cleanup
     XFreeStringList(list_return);
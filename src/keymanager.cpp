@@ -14,15 +14,40 @@
 #include "globals.h"
 #include "ipc-protocol.h"
 #include "keycombo.h"
+#include "mousemanager.h"
 #include "root.h"
+#include "settings.h"
 #include "utils.h"
 
 using std::endl;
+using std::pair;
 using std::string;
 using std::unique_ptr;
 
 KeyManager::~KeyManager() {
     xKeyGrabber_.ungrabAll();
+    xKeyGrabber_.setIgnoreLockMods(false);
+}
+
+void KeyManager::injectDependencies(Settings* s) {
+    settings_ = s;
+    settings_->xkb_ignore_lock_mods.changed().connect(this, &KeyManager::updateIgnoreLockMods);
+}
+
+//! Switch between grabbing every lock modifier combination and letting XKB
+//! ignore the lock modifiers, and regrab all bindings accordingly
+void KeyManager::updateIgnoreLockMods() {
+    bool ignore = settings_->xkb_ignore_lock_mods();
+    if (!xKeyGrabber_.setIgnoreLockMods(ignore)) {
+        HSWarning("XKB is not available, grabbing every lock modifier combination\n");
+    }
+    xKeyGrabber_.updateNumlockMask();
+    if (grabTransactionDepth_ > 0) {
+        grabsDirty_ = true;
+    } else {
+        applyGrabs();
+    }
+    Root::get()->mouse->grabFocusedClient();
 }
 
 int KeyManager::addKeybindCommand(Input input, Output output) {
@@ -46,9 +71,12 @@ int KeyManager::addKeybindCommand(Input input, Output output) {
     // Make sure there is no existing binding with same keysym/modifiers
     removeKeyBinding(newBinding->keyCombo);
 
-    if (!newBinding->keyCombo.matches(activeKeyMask_.regex)) {
+    newBinding->grabbed = false;
+    if (grabTransactionDepth_ > 0) {
+        grabsDirty_ = true;
+    } else if (!newBinding->keyCombo.matches(activeKeyMask_.regex)) {
         // Grab for events on this keycode
-        xKeyGrabber_.grabKeyCombo(newBinding->keyCombo);
+        newBinding->keycode = xKeyGrabber_.grabKeyCombo(newBinding->keyCombo);
         newBinding->grabbed = true;
     }
 
@@ -79,7 +107,11 @@ int KeyManager::removeKeybindCommand(Input input, Output output) {
 
     if (arg == "--all" || arg == "-F") {
         binds.clear();
-        xKeyGrabber_.ungrabAll();
+        if (grabTransactionDepth_ > 0) {
+            grabsDirty_ = true;
+        } else {
+            xKeyGrabber_.ungrabAll();
+        }
     } else {
         KeyCombo comboToRemove;
         try {
@@ -177,15 +209,65 @@ void KeyManager::handleKeyPress(XEvent* ev) const {
 void KeyManager::regrabAll() {
     xKeyGrabber_.updateNumlockMask();
 
+    if (grabTransactionDepth_ > 0) {
+        grabsDirty_ = true;
+        return;
+    }
+
      // Remove all current grabs:
     xKeyGrabber_.ungrabAll();
 
     for (auto& binding : binds) {
-        xKeyGrabber_.grabKeyCombo(binding->keyCombo);
+        binding->keycode = xKeyGrabber_.grabKeyCombo(binding->keyCombo);
         binding->grabbed = true;
     }
 }
 
+/*!
+ * Adapts the grabs to a changed keyboard or modifier mapping. Only the
+ * bindings whose keysym is now produced by a different keycode are regrabbed,
+ * unless the numlock mask changed, which affects every grab.
+ */
+void KeyManager::updateKeyboardMapping() {
+    unsigned int oldNumlockMask = xKeyGrabber_.getNumlockMask();
+    xKeyGrabber_.updateNumlockMask();
+    if (grabTransactionDepth_ > 0) {
+        grabsDirty_ = true;
+        return;
+    }
+    if (xKeyGrabber_.getNumlockMask() != oldNumlockMask) {
+        applyGrabs();
+        return;
+    }
+    // the keycodes and modifiers that were ungrabbed, in case another
+    // binding still needs them
+    std::set<pair<KeyCode, unsigned int>> released;
+    for (auto& binding : binds) {
+        if (!binding->grabbed) {
+            continue;
+        }
+        KeyCode keycode = xKeyGrabber_.keycodeFor(binding->keyCombo);
+        if (keycode == binding->keycode) {
+            continue;
+        }
+        if (binding->keycode) {
+            xKeyGrabber_.ungrabKeyCombo(binding->keyCombo, binding->keycode);
+            released.insert({binding->keycode, binding->keyCombo.modifiers});
+        }
+        binding->keycode = xKeyGrabber_.grabKeyCombo(binding->keyCombo);
+    }
+    if (released.empty()) {
+        return;
+    }
+    for (auto& binding : binds) {
+        if (binding->grabbed
+            && released.count({binding->keycode, binding->keyCombo.modifiers}))
+        {
+            xKeyGrabber_.grabKeyCombo(binding->keyCombo);
+        }
+    }
+}
+
 /*!
  * Makes sure that the currently active keymask is correct for the currently
  * focused client and regrabs keys if necessary
@@ -220,15 +302,20 @@ void KeyManager::ensureKeyMask(const Client* client) {
 
 //! Apply new keymask by grabbing/ungrabbing current bindings accordingly
 void KeyManager::setActiveKeyMask(const KeyMask& newMask) {
+    if (grabTransactionDepth_ > 0) {
+        activeKeyMask_ = newMask;
+        grabsDirty_ = true;
+        return;
+    }
     for (auto& binding : binds) {
         auto name = binding->keyCombo.str();
         bool isMasked = binding->keyCombo.matches(newMask.regex);
 
         if (!isMasked && !binding->grabbed) {
-            xKeyGrabber_.grabKeyCombo(binding->keyCombo);
+            binding->keycode = xKeyGrabber_.grabKeyCombo(binding->keyCombo);
             binding->grabbed = true;
         } else if (isMasked && binding->grabbed) {
-            xKeyGrabber_.ungrabKeyCombo(binding->keyCombo);
+            xKeyGrabber_.ungrabKeyCombo(binding->keyCombo, binding->keycode);
             binding->grabbed = false;
         }
     }
@@ -264,3 +351,29 @@ bool KeyManager::removeKeyBinding(const KeyCombo& comboToRemove) {
     binds.erase(removeIter);
     return True;
 }
+
+void KeyManager::beginGrabTransaction() {
+    grabTransactionDepth_++;
+}
+
+void KeyManager::endGrabTransaction() {
+    if (grabTransactionDepth_ <= 0) {
+        return;
+    }
+    grabTransactionDepth_--;
+    if (grabTransactionDepth_ == 0 && grabsDirty_) {
+        applyGrabs();
+    }
+}
+
+//! Replace all grabs by the ones of the current bindings and keymask
+void KeyManager::applyGrabs() {
+    grabsDirty_ = false;
+    xKeyGrabber_.ungrabAll();
+    for (auto& binding : binds) {
+        binding->grabbed = !binding->keyCombo.matches(activeKeyMask_.regex);
+        if (binding->grabbed) {
+            binding->keycode = xKeyGrabber_.grabKeyCombo(binding->keyCombo);
+        }
+    }
+}
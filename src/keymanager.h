@@ -15,6 +15,7 @@
 
 class Client;
 class Completion;
+class Settings;
 
 /*!
  * Maintains the list of key bindings, and handles the grabbing/ungrabbing with
@@ -59,11 +60,14 @@ private:
         KeyCombo keyCombo;
         std::vector<std::string> cmd;
         bool grabbed;
+        //! the keycode the binding was grabbed with
+        KeyCode keycode = 0;
     };
 
 public:
     KeyManager() = default;
     ~KeyManager();
+    void injectDependencies(Settings* s);
 
     int addKeybindCommand(Input input, Output output);
     int listKeybindsCommand(Output output) const;
@@ -75,18 +79,34 @@ public:
     void handleKeyPress(XEvent* ev) const;
 
     void regrabAll();
+    void updateKeyboardMapping();
     void ensureKeyMask(const Client* client = nullptr);
     void setActiveKeyMask(const KeyMask& newMask);
     void clearActiveKeyMask();
 
+    /*!
+     * Between these calls, changes to the key bindings only update the list
+     * of bindings, and the resulting grabs are applied in a single pass by the
+     * outermost endGrabTransaction(). Transactions can be nested.
+     */
+    void beginGrabTransaction();
+    void endGrabTransaction();
+
     // TODO: This is not supposed to exist. It only does as a workaround,
     // because mouse.cpp still wants to know the numlock mask.
     unsigned int getNumlockMask() const {
         return xKeyGrabber_.getNumlockMask();
     }
+    std::vector<unsigned int> lockModifierCombinations() const {
+        return xKeyGrabber_.lockModifierCombinations();
+    }
 
 private:
     bool removeKeyBinding(const KeyCombo& comboToRemove);
+    void applyGrabs();
+    void updateIgnoreLockMods();
+
+    Settings* settings_ = nullptr;
 
     //! Currently defined keybindings
     std::vector<std::unique_ptr<KeyBinding>> binds;
@@ -95,4 +115,9 @@ private:
 
     // The last known keymask (for comparison on change)
     KeyMask activeKeyMask_;
+
+    // the nesting depth of grab transactions and whether the grabs need to
+    // be applied when the outermost one ends
+    int grabTransactionDepth_ = 0;
+    bool grabsDirty_ = false;
 };
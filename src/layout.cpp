@@ -12,20 +12,20 @@
 #include "frametree.h" // TODO: remove this dependency!
 #include "globals.h"
 #include "ipc-protocol.h"
+#include "layoutgeometry.h"
 #include "monitor.h"
 #include "monitormanager.h"
 #include "settings.h"
 #include "tagmanager.h"
 #include "utils.h"
 
-using std::dynamic_pointer_cast;
 using std::function;
 using std::make_shared;
 using std::shared_ptr;
+using std::static_pointer_cast;
 using std::string;
 using std::swap;
 using std::vector;
-using std::weak_ptr;
 
 const char* g_align_names[] = {
     "vertical",
@@ -47,23 +47,24 @@ void reset_frame_colors() {
 /* create a new frame
  * you can either specify a frame or a tag as its parent
  */
-HSFrame::HSFrame(HSTag* tag, Settings* settings, weak_ptr<HSFrameSplit> parent)
+HSFrame::HSFrame(HSTag* tag, Settings* settings, HSFrameSplit* parent)
     : tag_(tag)
     , settings_(settings)
     , parent_(parent)
 {}
 HSFrame::~HSFrame() = default;
 
-HSFrameLeaf::HSFrameLeaf(HSTag* tag, Settings* settings, weak_ptr<HSFrameSplit> parent)
+HSFrameLeaf::HSFrameLeaf(HSTag* tag, Settings* settings, HSFrameSplit* parent)
     : HSFrame(tag, settings, parent)
     , selection(0)
 {
     layout = settings->default_frame_layout();
 
     decoration = new FrameDecoration(tag, settings);
+    tag_->frameCountChanged(1);
 }
 
-HSFrameSplit::HSFrameSplit(HSTag* tag, Settings* settings, weak_ptr<HSFrameSplit> parent, int fraction, int align,
+HSFrameSplit::HSFrameSplit(HSTag* tag, Settings* settings, HSFrameSplit* parent, int fraction, int align,
                  shared_ptr<HSFrame> a, shared_ptr<HSFrame> b)
              : HSFrame(tag, settings, parent) {
     this->align_ = align;
@@ -76,18 +77,28 @@ HSFrameSplit::HSFrameSplit(HSTag* tag, Settings* settings, weak_ptr<HSFrameSplit
 void HSFrameLeaf::insertClient(Client* client) {
     // insert it after the selection
     clients.insert(clients.begin() + std::min((selection + 1), (int)clients.size()), client);
+    client->frameLeaf_ = this;
+    tag_->clientCountChanged(1);
     // FRAMETODO: if we we are focused, and were empty before, we have to focus
     // the client now
 }
 
 shared_ptr<HSFrameLeaf> HSFrameSplit::frameWithClient(Client* client) {
-    auto found = a_->frameWithClient(client);
-    if (found) return found;
-    else return b_->frameWithClient(client);
+    HSFrameLeaf* leaf = client->frameLeaf_;
+    if (!leaf) {
+        return shared_ptr<HSFrameLeaf>();
+    }
+    // check whether the leaf holding the client is below this
+    for (HSFrameSplit* node = leaf->parent_; node; node = node->parent_) {
+        if (node == this) {
+            return leaf->thisLeaf();
+        }
+    }
+    return shared_ptr<HSFrameLeaf>();
 }
 
 shared_ptr<HSFrameLeaf> HSFrameLeaf::frameWithClient(Client* client) {
-    if (find(clients.begin(), clients.end(), client) != clients.end()) {
+    if (client->frameLeaf_ == this) {
         return thisLeaf();
     } else {
         return shared_ptr<HSFrameLeaf>();
@@ -95,10 +106,15 @@ shared_ptr<HSFrameLeaf> HSFrameLeaf::frameWithClient(Client* client) {
 }
 
 bool HSFrameLeaf::removeClient(Client* client) {
+    if (client->frameLeaf_ != this) {
+        return false;
+    }
     auto it = find(clients.begin(), clients.end(), client);
     if (it != clients.end()) {
         auto idx = it - clients.begin();
         clients.erase(it);
+        client->frameLeaf_ = nullptr;
+        tag_->clientCountChanged(-1);
         // find out new selection
         // if selection was before removed window
         // then do nothing
@@ -113,13 +129,22 @@ bool HSFrameLeaf::removeClient(Client* client) {
 }
 
 bool HSFrameSplit::removeClient(Client* client) {
-    return a_->removeClient(client) || b_->removeClient(client);
+    auto leaf = frameWithClient(client);
+    return leaf && leaf->removeClient(client);
 }
 
 
 HSFrameSplit::~HSFrameSplit() = default;
 
 HSFrameLeaf::~HSFrameLeaf() {
+    for (auto c : clients) {
+        // the client may already have been inserted into another frame
+        if (c->frameLeaf_ == this) {
+            c->frameLeaf_ = nullptr;
+        }
+    }
+    tag_->clientCountChanged(-(int)clients.size());
+    tag_->frameCountChanged(-1);
     // free other things
     delete decoration;
 }
@@ -146,27 +171,28 @@ int find_align_by_name(char* name) {
 }
 
 shared_ptr<HSFrame> HSFrame::root() {
-    auto parent_shared = parent_.lock();
-    if (parent_shared) return parent_shared->root();
-    else return shared_from_this();
+    HSFrame* node = this;
+    while (node->parent_) {
+        node = node->parent_;
+    }
+    return node->shared_from_this();
 }
 
 bool HSFrame::isFocused() {
-    auto p = parent_.lock();
-    if (!p) {
-        return true;
-    } else {
-        return p->selectedChild() == shared_from_this()
-               && p->isFocused();
+    for (HSFrame* node = this; node->parent_; node = node->parent_) {
+        if (node->parent_->selectedChild().get() != node) {
+            return false;
+        }
     }
+    return true;
 }
 
 shared_ptr<HSFrameLeaf> HSFrameLeaf::thisLeaf() {
-    return dynamic_pointer_cast<HSFrameLeaf>(shared_from_this());
+    return static_pointer_cast<HSFrameLeaf>(shared_from_this());
 }
 
 shared_ptr<HSFrameSplit> HSFrameSplit::thisSplit() {
-    return dynamic_pointer_cast<HSFrameSplit>(shared_from_this());
+    return static_pointer_cast<HSFrameSplit>(shared_from_this());
 }
 
 shared_ptr<HSFrameLeaf> HSFrame::getGloballyFocusedFrame() {
@@ -228,186 +254,21 @@ int frame_current_set_client_layout(int argc, char** argv, Output output) {
     return 0;
 }
 
-TilingResult HSFrameLeaf::layoutLinear(Rectangle rect, bool vertical) {
-    TilingResult res;
-    auto cur = rect;
-    int last_step_y;
-    int last_step_x;
-    int step_y;
-    int step_x;
-    int count = clients.size();
-    if (vertical) {
-        // only do steps in y direction
-        last_step_y = cur.height % count; // get the space on bottom
-        last_step_x = 0;
-        cur.height /= count;
-        step_y = cur.height;
-        step_x = 0;
-    } else {
-        // only do steps in x direction
-        last_step_y = 0;
-        last_step_x = cur.width % count; // get the space on the right
-        cur.width /= count;
-        step_y = 0;
-        step_x = cur.width;
-    }
-    int i = 0;
-    for (auto client : clients) {
-        // add the space, if count does not divide frameheight without remainder
-        cur.height += (i == count-1) ? last_step_y : 0;
-        cur.width += (i == count-1) ? last_step_x : 0;
-        res[client] = TilingStep(cur);
-        cur.y += step_y;
-        cur.x += step_x;
-        i++;
-    }
-    return res;
-}
-
-TilingResult HSFrameLeaf::layoutMax(Rectangle rect) {
-    TilingResult res;
-    for (auto client : clients) {
-        TilingStep step(rect);
-        if (client == clients[selection]) {
-            step.needsRaise = true;
-        }
-        res[client] = step;
-    }
-    return res;
-}
-
-void frame_layout_grid_get_size(size_t count, int* res_rows, int* res_cols) {
-    unsigned cols = 0;
-    while (cols * cols < count) {
-        cols++;
-    }
-    *res_cols = cols;
-    if (*res_cols != 0) {
-        *res_rows = (count / cols) + (count % cols ? 1 : 0);
-    } else {
-        *res_rows = 0;
-    }
-}
-
-TilingResult HSFrameLeaf::layoutGrid(Rectangle rect) {
-    TilingResult res;
-    if (clients.size() == 0) return res;
-
-    int rows, cols;
-    frame_layout_grid_get_size(clients.size(), &rows, &cols);
-    int width = rect.width / cols;
-    int height = rect.height / rows;
-    int i = 0;
-    auto cur = rect; // current rectangle
-    for (int r = 0; r < rows; r++) {
-        // reset to left
-        cur.x = rect.x;
-        cur.width = width;
-        cur.height = height;
-        if (r == rows -1) {
-            // fill small pixel gap below last row
-            cur.height += rect.height % rows;
-        }
-        int count = clients.size();
-        for (int c = 0; c < cols && i < count; c++) {
-            if (settings_->gapless_grid() && (i == count - 1) // if last client
-                && (count % cols != 0)) {           // if cols remain
-                // fill remaining cols with client
-                cur.width = rect.x + rect.width - cur.x;
-            } else if (c == cols - 1) {
-                // fill small pixel gap in last col
-                cur.width += rect.width % cols;
-            }
-
-            // apply size
-            res[clients[i]] = TilingStep(cur);
-            cur.x += width;
-            i++;
-        }
-        cur.y += height;
-    }
-    return res;
+void HSFrameLeaf::computeLayout(Rectangle rect, const LayoutSettings& settings,
+                                TilingResult& res) {
+    last_rect = rect;
+    bool covered = layout == LAYOUT_MAX && clients.size() > 0
+        && clients[selection]->coversTile();
+    LeafLayout leaf = {
+        clients, selection, layout, parent_ != nullptr, covered, decoration,
+    };
+    layout_leaf_frame(rect, settings, leaf, res);
 }
 
-TilingResult HSFrameLeaf::computeLayout(Rectangle rect) {
-    last_rect = rect;
-    if (!settings_->smart_frame_surroundings() || parent_.lock()) {
-        // apply frame gap
-        rect.height -= settings_->frame_gap();
-        rect.width -= settings_->frame_gap();
-        // apply frame border
-        rect.x += settings_->frame_border_width();
-        rect.y += settings_->frame_border_width();
-        rect.height -= settings_->frame_border_width() * 2;
-        rect.width -= settings_->frame_border_width() * 2;
-    }
-
-    rect.width = std::max(WINDOW_MIN_WIDTH, rect.width);
-    rect.height = std::max(WINDOW_MIN_HEIGHT, rect.height);
-
-    // move windows
-    TilingResult res;
-    FrameDecorationData frame_data;
-    frame_data.geometry = rect;
-    frame_data.visible = true;
-    frame_data.hasClients = clients.size() > 0;
-    frame_data.hasParent = (bool)parent_.lock();
-    res.focused_frame = decoration;
-    res.add(decoration, frame_data);
-    if (clients.size() == 0) {
-        return res;
-    }
-
-    if (!smart_window_surroundings_active(this)) {
-        // apply window gap
-        auto window_gap = settings_->window_gap();
-        rect.x += window_gap;
-        rect.y += window_gap;
-        rect.width -= window_gap;
-        rect.height -= window_gap;
-
-        // apply frame padding
-        auto frame_padding = settings_->frame_padding();
-        rect.x += frame_padding;
-        rect.y += frame_padding;
-        rect.width  -= frame_padding * 2;
-        rect.height -= frame_padding * 2;
-    }
-    TilingResult layoutResult;
-    if (layout == LAYOUT_MAX) {
-        layoutResult = layoutMax(rect);
-    } else if (layout == LAYOUT_GRID) {
-        layoutResult = layoutGrid(rect);
-    } else if (layout == LAYOUT_VERTICAL) {
-        layoutResult = layoutVertical(rect);
-    } else {
-        layoutResult = layoutHorizontal(rect);
-    }
-    res.mergeFrom(layoutResult);
-    res.focus = clients[selection];
-    return res;
-}
-
-TilingResult HSFrameSplit::computeLayout(Rectangle rect) {
-    auto first = rect;
-    auto second = rect;
-    if (align_ == ALIGN_VERTICAL) {
-        first.height = (rect.height * fraction_) / FRACTION_UNIT;
-        second.y += first.height;
-        second.height -= first.height;
-    } else { // (align == ALIGN_HORIZONTAL)
-        first.width = (rect.width * fraction_) / FRACTION_UNIT;
-        second.x += first.width;
-        second.width -= first.width;
-    }
-    TilingResult res;
-    auto res1 = a_->computeLayout(first);
-    auto res2 = b_->computeLayout(second);
-    res.mergeFrom(res1);
-    res.mergeFrom(res2);
-    res.focus = (selection_ == 0) ? res1.focus : res2.focus;
-    res.focused_frame = (selection_ == 0) ? res1.focused_frame : res2.focused_frame;
-    return res;
+void HSFrameSplit::computeLayout(Rectangle rect, const LayoutSettings& settings,
+                                 TilingResult& res) {
+    layout_split_frame(rect, settings, align_ == ALIGN_VERTICAL, fraction_,
+                       selection_, *a_, *b_, res);
 }
 
 void HSFrameSplit::fmap(function<void(HSFrameSplit*)> onSplit, function<void(HSFrameLeaf*)> onLeaf, int order) {
@@ -470,29 +331,39 @@ void HSFrameLeaf::setSelection(int index) {
 }
 
 int HSFrame::splitsToRoot(int align) {
-    if (!parent_.lock()) return 0;
-    return parent_.lock()->splitsToRoot(align);
+    int count = 0;
+    // the root itself is never counted
+    for (HSFrameSplit* s = parent_; s && s->parent_; s = s->parent_) {
+        if (s->getAlign() == align) {
+            count++;
+        }
+    }
+    return count;
 }
 int HSFrameSplit::splitsToRoot(int align) {
-    if (!parent_.lock()) return 0;
+    if (!parent_) return 0;
     int delta = 0;
     if (this->align_ == align) delta = 1;
-    return delta + parent_.lock()->splitsToRoot(align);
+    return delta + HSFrame::splitsToRoot(align);
 }
 
 void HSFrameSplit::replaceChild(shared_ptr<HSFrame> old, shared_ptr<HSFrame> newchild) {
     if (a_ == old) {
         a_ = newchild;
-        newchild->parent_ = thisSplit();
+        newchild->parent_ = this;
     }
     if (b_ == old) {
         b_ = newchild;
-        newchild->parent_ = thisSplit();
+        newchild->parent_ = this;
     }
 }
 
 void HSFrameLeaf::addClients(const vector<Client*>& vec) {
-    for (auto c : vec) clients.push_back(c);
+    for (auto c : vec) {
+        clients.push_back(c);
+        c->frameLeaf_ = this;
+    }
+    tag_->clientCountChanged(vec.size());
 }
 
 bool HSFrameLeaf::split(int alignment, int fraction, size_t childrenLeaving) {
@@ -502,22 +373,23 @@ bool HSFrameLeaf::split(int alignment, int fraction, size_t childrenLeaving) {
     int childrenStaying = std::max((size_t)0, clients.size() - childrenLeaving);
     vector<Client*> leaves(clients.begin() + childrenStaying, clients.end());
     clients.erase(clients.begin() + childrenStaying, clients.end());
+    tag_->clientCountChanged(-(int)leaves.size());
     // ensure fraction is allowed
     fraction = CLAMP(fraction,
                      FRACTION_UNIT * (0.0 + FRAME_MIN_FRACTION),
                      FRACTION_UNIT * (1.0 - FRAME_MIN_FRACTION));
     auto first = shared_from_this();
-    auto second = make_shared<HSFrameLeaf>(tag_, settings_, weak_ptr<HSFrameSplit>());
+    auto second = make_shared<HSFrameLeaf>(tag_, settings_, nullptr);
     second->layout = layout;
     auto new_this = make_shared<HSFrameSplit>(tag_, settings_, parent_, fraction, alignment, first, second);
-    second->parent_ = new_this;
+    second->parent_ = &* new_this;
     second->addClients(leaves);
-    if (parent_.lock()) {
-        parent_.lock()->replaceChild(shared_from_this(), new_this);
+    if (parent_) {
+        parent_->replaceChild(shared_from_this(), new_this);
     } else {
         tag_->frame->root_ = new_this;
     }
-    parent_ = new_this;
+    parent_ = &* new_this;
     if (selection >= childrenStaying) {
         second->setSelection(selection - childrenStaying);
         selection = std::max(0, childrenStaying - 1);
@@ -669,36 +541,36 @@ void HSFrameSplit::adjustFraction(int delta) {
 shared_ptr<HSFrame> HSFrameLeaf::neighbour(Direction direction) {
     bool found = false;
     shared_ptr<HSFrame> other;
-    shared_ptr<HSFrame> child = shared_from_this();
-    shared_ptr<HSFrameSplit> frame = getParent();
+    HSFrame* child = this;
+    HSFrameSplit* frame = parent_;
     while (frame) {
         // find frame, where we can change the
         // selection in the desired direction
         switch(direction) {
             case Direction::Right:
                 if (frame->getAlign() == ALIGN_HORIZONTAL
-                    && frame->firstChild() == child) {
+                    && frame->firstChild().get() == child) {
                     found = true;
                     other = frame->secondChild();
                 }
                 break;
             case Direction::Left:
                 if (frame->getAlign() == ALIGN_HORIZONTAL
-                    && frame->secondChild() == child) {
+                    && frame->secondChild().get() == child) {
                     found = true;
                     other = frame->firstChild();
                 }
                 break;
             case Direction::Down:
                 if (frame->getAlign() == ALIGN_VERTICAL
-                    && frame->firstChild() == child) {
+                    && frame->firstChild().get() == child) {
                     found = true;
                     other = frame->secondChild();
                 }
                 break;
             case Direction::Up:
                 if (frame->getAlign() == ALIGN_VERTICAL
-                    && frame->secondChild() == child) {
+                    && frame->secondChild().get() == child) {
                     found = true;
                     other = frame->firstChild();
                 }
@@ -708,7 +580,7 @@ shared_ptr<HSFrame> HSFrameLeaf::neighbour(Direction direction) {
         }
         // else: go one step closer to root
         child = frame;
-        frame = frame->getParent();
+        frame = frame->parent_;
     }
     if (!found) {
         return shared_ptr<HSFrame>();
@@ -797,11 +669,11 @@ int frame_focus_command(int argc, char** argv, Output output) {
     } else {
         shared_ptr<HSFrame> neighbour = frame->neighbour(direction);
         if (neighbour) { // if neighbour was found
-            shared_ptr<HSFrameSplit> parent = neighbour->getParent();
+            HSFrameSplit* parent = neighbour->getParent();
             // alter focus (from 0 to 1, from 1 to 0)
             parent->swapSelection();
             // change focus if possible
-            frame_focus_recursive(parent);
+            frame_focus_recursive(parent->thisSplit());
             get_current_monitor()->applyLayout();
         } else {
             neighbour_found = false;
@@ -871,10 +743,10 @@ int frame_move_window_command(int argc, char** argv, Output output) {
             neighbour->frameWithClient(client)->select(client);
 
             // change selection in parent
-            shared_ptr<HSFrameSplit> parent = neighbour->getParent();
+            HSFrameSplit* parent = neighbour->getParent();
             assert(parent);
             parent->swapSelection();
-            frame_focus_recursive(parent);
+            frame_focus_recursive(parent->thisSplit());
 
             // layout was changed, so update it
             get_current_monitor()->applyLayout();
@@ -950,10 +822,12 @@ bool focus_client(Client* client, bool switch_tag, bool switch_monitor) {
 
 void HSFrame::setVisibleRecursive(bool visible) {
     auto onSplit = [] (HSFrameSplit* frame) { };
+    // a container window hides the frames of its tag already
+    bool hideFrames = !visible && !tag_->hasContainer();
     // X11 tweaks here.
     auto onLeaf =
-        [visible] (HSFrameLeaf* frame) {
-            if (!visible) {
+        [visible,hideFrames] (HSFrameLeaf* frame) {
+            if (hideFrames) {
                 frame->decoration->hide();
             }
             for (auto c : frame->clients) c->set_visible(visible);
@@ -965,6 +839,12 @@ void HSFrame::setVisibleRecursive(bool visible) {
 vector<Client*> HSFrameLeaf::removeAllClients() {
     vector<Client*> result;
     swap(result, clients);
+    for (auto c : result) {
+        if (c->frameLeaf_ == this) {
+            c->frameLeaf_ = nullptr;
+        }
+    }
+    tag_->clientCountChanged(-(int)result.size());
     selection = 0;
     return result;
 }
@@ -993,10 +873,16 @@ int frame_move_window_edge(int argc, char** argv, Output output) {
     return 0;
 }
 
-bool smart_window_surroundings_active(HSFrameLeaf* frame) {
-    return g_settings->smart_window_surroundings()
-            && (frame->clientCount() == 1
-                || frame->getLayout() == LAYOUT_MAX);
+LayoutSettings layout_settings(Settings* settings) {
+    LayoutSettings values;
+    values.frameGap = settings->frame_gap();
+    values.frameBorderWidth = settings->frame_border_width();
+    values.windowGap = settings->window_gap();
+    values.framePadding = settings->frame_padding();
+    values.gaplessGrid = settings->gapless_grid();
+    values.smartFrameSurroundings = settings->smart_frame_surroundings();
+    values.smartWindowSurroundings = settings->smart_window_surroundings();
+    return values;
 }
 
 void frame_focus_recursive(shared_ptr<HSFrame> frame) {
@@ -6,6 +6,8 @@
 #include <functional>
 #include <memory>
 
+#include "framelayout.h"
+#include "layoutgeometry.h"
 #include "tilingresult.h"
 #include "types.h"
 #include "x11-types.h"
@@ -15,21 +17,6 @@
 #define LAYOUT_DUMP_SEPARATOR_STR ":" /* must be a string with one char */
 #define LAYOUT_DUMP_SEPARATOR LAYOUT_DUMP_SEPARATOR_STR[0]
 
-enum {
-    ALIGN_VERTICAL = 0,
-    ALIGN_HORIZONTAL,
-    // temporary values in split_command
-    ALIGN_EXPLODE,
-};
-
-enum {
-    LAYOUT_VERTICAL = 0,
-    LAYOUT_HORIZONTAL,
-    LAYOUT_MAX,
-    LAYOUT_GRID,
-    LAYOUT_COUNT,
-};
-
 extern const char* g_align_names[];
 extern const char* g_layout_names[];
 
@@ -43,23 +30,20 @@ enum {
 class Client;
 typedef std::function<void(Client*)> ClientAction;
 
-#define FRACTION_UNIT 10000
-
 class HSTag;
 class HSFrameLeaf;
 class HSFrameSplit;
 class Settings;
 
-class HSFrame : public std::enable_shared_from_this<HSFrame> {
+class HSFrame : public FrameLayout, public std::enable_shared_from_this<HSFrame> {
 protected:
-    HSFrame(HSTag* tag, Settings* settings, std::weak_ptr<HSFrameSplit> parent);
+    HSFrame(HSTag* tag, Settings* settings, HSFrameSplit* parent);
     virtual ~HSFrame();
 public:
     virtual std::shared_ptr<HSFrameLeaf> frameWithClient(Client* client) = 0;
     virtual bool removeClient(Client* client) = 0;
 
     virtual bool isFocused();
-    virtual TilingResult computeLayout(Rectangle rect) = 0;
     virtual Client* focusedClient() = 0;
 
     // do recursive for each element of the (binary) frame tree
@@ -74,7 +58,7 @@ public:
     }
     void foreachClient(ClientAction action);
 
-    std::shared_ptr<HSFrameSplit> getParent() { return parent_.lock(); };
+    HSFrameSplit* getParent() { return parent_; }
     std::shared_ptr<HSFrame> root();
     // count the number of splits to the root with alignment "align"
     virtual int splitsToRoot(int align);
@@ -91,31 +75,28 @@ public:
      */
     template <typename ReturnType>
     ReturnType switchcase(std::function<ReturnType(std::shared_ptr<HSFrameLeaf>)> onLeaf,
-                          std::function<ReturnType(std::shared_ptr<HSFrameSplit>)> onSplit) {
-        auto s = isSplit();
-        if (s) {
-            return onSplit(s);
-        }
-        // if it is not a split, it must be a leaf
-        auto l = isLeaf();
-        assert(l);
-        return onLeaf(l);
-    }
+                          std::function<ReturnType(std::shared_ptr<HSFrameSplit>)> onSplit);
 
+    friend class HSFrameLeaf;
     friend class HSFrameSplit;
     friend class FrameTree;
 public: // soon will be protected:
-    virtual std::shared_ptr<HSFrameSplit> isSplit() { return std::shared_ptr<HSFrameSplit>(); };
-    virtual std::shared_ptr<HSFrameLeaf> isLeaf() { return std::shared_ptr<HSFrameLeaf>(); };
+    // plain pointers, such that a case distinction does not touch the
+    // reference count
+    virtual HSFrameSplit* isSplit() { return nullptr; };
+    virtual HSFrameLeaf* isLeaf() { return nullptr; };
 protected:
     HSTag* tag_;
     Settings* settings_;
-    std::weak_ptr<HSFrameSplit> parent_;
+    // the split owning this node (or nullptr for the root). The parent owns
+    // its children, so a plain pointer avoids locking a weak_ptr on every
+    // step towards the root.
+    HSFrameSplit* parent_;
 };
 
 class HSFrameLeaf : public HSFrame {
 public:
-    HSFrameLeaf(HSTag* tag, Settings* settings, std::weak_ptr<HSFrameSplit> parent);
+    HSFrameLeaf(HSTag* tag, Settings* settings, HSFrameSplit* parent);
     ~HSFrameLeaf() override;
 
     // inherited:
@@ -124,7 +105,8 @@ public:
     bool removeClient(Client* client) override;
     void moveClient(int new_index);
 
-    TilingResult computeLayout(Rectangle rect) override;
+    void computeLayout(Rectangle rect, const LayoutSettings& settings,
+                       TilingResult& res) override;
 
     virtual void fmap(std::function<void(HSFrameSplit*)> onSplit,
                       std::function<void(HSFrameLeaf*)> onLeaf, int order) override;
@@ -147,19 +129,14 @@ public:
     std::vector<Client*> removeAllClients();
 
     std::shared_ptr<HSFrameLeaf> thisLeaf();
-    std::shared_ptr<HSFrameLeaf> isLeaf() override { return thisLeaf(); }
+    HSFrameLeaf* isLeaf() override { return this; }
 
     friend class HSFrame;
     void setVisible(bool visible);
     Rectangle lastRect() { return last_rect; }
+    FrameDecoration* getDecoration() { return decoration; }
 private:
     friend class FrameTree;
-    // layout algorithms
-    TilingResult layoutLinear(Rectangle rect, bool vertical);
-    TilingResult layoutHorizontal(Rectangle rect) { return layoutLinear(rect, false); };
-    TilingResult layoutVertical(Rectangle rect) { return layoutLinear(rect, true); };
-    TilingResult layoutMax(Rectangle rect);
-    TilingResult layoutGrid(Rectangle rect);
 
     // members
     std::vector<Client*> clients;
@@ -173,14 +150,15 @@ private:
 
 class HSFrameSplit : public HSFrame {
 public:
-    HSFrameSplit(HSTag* tag, Settings* settings, std::weak_ptr<HSFrameSplit> parent, int fraction_, int align_,
+    HSFrameSplit(HSTag* tag, Settings* settings, HSFrameSplit* parent, int fraction_, int align_,
                  std::shared_ptr<HSFrame> a_, std::shared_ptr<HSFrame> b_);
     ~HSFrameSplit() override;
     // inherited:
     std::shared_ptr<HSFrameLeaf> frameWithClient(Client* client) override;
     bool removeClient(Client* client) override;
 
-    TilingResult computeLayout(Rectangle rect) override;
+    void computeLayout(Rectangle rect, const LayoutSettings& settings,
+                       TilingResult& res) override;
 
     virtual void fmap(std::function<void(HSFrameSplit*)> onSplit,
                       std::function<void(HSFrameLeaf*)> onLeaf, int order) override;
@@ -190,13 +168,13 @@ public:
     // own members
     int splitsToRoot(int align_) override;
     void replaceChild(std::shared_ptr<HSFrame> old, std::shared_ptr<HSFrame> newchild);
-    std::shared_ptr<HSFrame> firstChild() { return a_; }
-    std::shared_ptr<HSFrame> secondChild() { return b_; }
-    std::shared_ptr<HSFrame> selectedChild() { return selection_ ? b_ : a_; }
+    const std::shared_ptr<HSFrame>& firstChild() { return a_; }
+    const std::shared_ptr<HSFrame>& secondChild() { return b_; }
+    const std::shared_ptr<HSFrame>& selectedChild() { return selection_ ? b_ : a_; }
     void swapChildren();
     void adjustFraction(int delta);
     std::shared_ptr<HSFrameSplit> thisSplit();
-    std::shared_ptr<HSFrameSplit> isSplit() override { return thisSplit(); }
+    HSFrameSplit* isSplit() override { return this; }
     int getAlign() { return align_; }
     void swapSelection() { selection_ = 1 - selection_; }
     void setSelection(int s) { selection_ = s; }
@@ -212,6 +190,19 @@ private:
                   // FRACTION_UNIT/2 means 50%
 };
 
+template <typename ReturnType>
+ReturnType HSFrame::switchcase(std::function<ReturnType(std::shared_ptr<HSFrameLeaf>)> onLeaf,
+                               std::function<ReturnType(std::shared_ptr<HSFrameSplit>)> onSplit) {
+    auto s = isSplit();
+    if (s) {
+        return onSplit(s->thisSplit());
+    }
+    // if it is not a split, it must be a leaf
+    auto l = isLeaf();
+    assert(l);
+    return onLeaf(l->thisLeaf());
+}
+
 // globals
 extern int* g_frame_gap;
 extern int* g_window_gap;
@@ -249,7 +240,8 @@ int frame_move_window_command(int argc, char** argv, Output output);
 int frame_focus_edge(int argc, char** argv, Output output);
 int frame_move_window_edge(int argc, char** argv, Output output);
 
-bool smart_window_surroundings_active(HSFrameLeaf* frame);
+//! the current values of the settings that affect the layout
+LayoutSettings layout_settings(Settings* settings);
 
 #endif
 
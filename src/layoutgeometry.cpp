@@ -0,0 +1,125 @@
+#include "layoutgeometry.h"
+
+#include <algorithm>
+
+using std::make_pair;
+using std::pair;
+
+pair<Rectangle, Rectangle> layout_split(Rectangle rect, bool vertical,
+                                        int fraction) {
+    auto first = rect;
+    auto second = rect;
+    if (vertical) {
+        first.height = (rect.height * fraction) / FRACTION_UNIT;
+        second.y += first.height;
+        second.height -= first.height;
+    } else {
+        first.width = (rect.width * fraction) / FRACTION_UNIT;
+        second.x += first.width;
+        second.width -= first.width;
+    }
+    return make_pair(first, second);
+}
+
+Rectangle layout_frame_content(Rectangle rect, int frame_gap,
+                               int frame_border_width) {
+    rect.height -= frame_gap;
+    rect.width -= frame_gap;
+    rect.x += frame_border_width;
+    rect.y += frame_border_width;
+    rect.height -= frame_border_width * 2;
+    rect.width -= frame_border_width * 2;
+    return rect;
+}
+
+Rectangle layout_leaf_content(Rectangle rect, bool decorated, int frame_gap,
+                              int frame_border_width,
+                              int min_width, int min_height) {
+    if (decorated) {
+        rect = layout_frame_content(rect, frame_gap, frame_border_width);
+    }
+    rect.width = std::max(min_width, rect.width);
+    rect.height = std::max(min_height, rect.height);
+    return rect;
+}
+
+Rectangle layout_client_area(Rectangle rect, int window_gap,
+                             int frame_padding) {
+    rect.x += window_gap;
+    rect.y += window_gap;
+    rect.width -= window_gap;
+    rect.height -= window_gap;
+
+    rect.x += frame_padding;
+    rect.y += frame_padding;
+    rect.width  -= frame_padding * 2;
+    rect.height -= frame_padding * 2;
+    return rect;
+}
+
+Rectangle layout_linear_cell(Rectangle rect, bool vertical,
+                             size_t count, size_t index) {
+    auto cur = rect;
+    int i = (int)index;
+    int n = (int)count;
+    if (vertical) {
+        // only do steps in y direction
+        cur.height = rect.height / n;
+        cur.y += i * cur.height;
+        if (i == n - 1) {
+            // add the space on the bottom
+            cur.height += rect.height % n;
+        }
+    } else {
+        // only do steps in x direction
+        cur.width = rect.width / n;
+        cur.x += i * cur.width;
+        if (i == n - 1) {
+            // add the space on the right
+            cur.width += rect.width % n;
+        }
+    }
+    return cur;
+}
+
+void frame_layout_grid_get_size(size_t count, int* res_rows, int* res_cols) {
+    unsigned cols = 0;
+    while (cols * cols < count) {
+        cols++;
+    }
+    *res_cols = cols;
+    if (*res_cols != 0) {
+        *res_rows = (count / cols) + (count % cols ? 1 : 0);
+    } else {
+        *res_rows = 0;
+    }
+}
+
+Rectangle layout_grid_cell(Rectangle rect, int rows, int cols,
+                           size_t count, size_t index, bool gapless) {
+    int i = (int)index;
+    int n = (int)count;
+    int r = i / cols;
+    int c = i % cols;
+    int width = rect.width / cols;
+    int height = rect.height / rows;
+    Rectangle cur = {
+        rect.x + c * width,
+        rect.y + r * height,
+        width,
+        height,
+    };
+    if (r == rows - 1) {
+        // fill small pixel gap below last row
+        cur.height += rect.height % rows;
+    }
+    if (gapless && (i == n - 1) // if last client
+        && (n % cols != 0)) {   // if cols remain
+        // fill remaining cols with client
+        cur.width = rect.x + rect.width - cur.x;
+    } else if (c == cols - 1) {
+        // fill small pixel gap in last col
+        cur.width += rect.width % cols;
+    }
+    return cur;
+}
@@ -0,0 +1,46 @@
+#ifndef __HERBSTLUFT_LAYOUTGEOMETRY_H_
+#define __HERBSTLUFT_LAYOUTGEOMETRY_H_
+
+#include <cstddef>
+#include <utility>
+
+#include "x11-types.h"
+
+/* The geometry of the frame layouts. The functions only do the arithmetic
+ * and know nothing about clients, tags, settings or the X server, so they
+ * are built as a library of their own that also the layout benchmark links
+ * against.
+ */
+
+#define FRACTION_UNIT 10000
+
+//! the rectangles of the two children of a split with the given fraction
+std::pair<Rectangle, Rectangle> layout_split(Rectangle rect, bool vertical,
+                                             int fraction);
+
+//! the area within a frame, i.e. without frame gap and frame border
+Rectangle layout_frame_content(Rectangle rect, int frame_gap,
+                               int frame_border_width);
+
+//! the content area of a leaf frame with the given minimum size. Only a
+//! decorated frame loses the frame gap and frame border.
+Rectangle layout_leaf_content(Rectangle rect, bool decorated, int frame_gap,
+                              int frame_border_width,
+                              int min_width, int min_height);
+
+//! the area for the clients within a frame's content area
+Rectangle layout_client_area(Rectangle rect, int window_gap,
+                             int frame_padding);
+
+//! the geometry of the index-th of count clients in a linear layout
+Rectangle layout_linear_cell(Rectangle rect, bool vertical,
+                             size_t count, size_t index);
+
+//! the number of rows and columns of a grid with count clients
+void frame_layout_grid_get_size(size_t count, int* res_rows, int* res_cols);
+
+//! the geometry of the index-th of count clients in a grid of the given size
+Rectangle layout_grid_cell(Rectangle rect, int rows, int cols,
+                           size_t count, size_t index, bool gapless);
+
+#endif
@@ -3,6 +3,7 @@
 #include <X11/Xlib.h>
 #include <getopt.h>
 #include <sys/select.h>
+#include <sys/time.h>
 #include <sys/wait.h>
 #include <unistd.h>
 #include <cassert>
@@ -13,9 +14,11 @@
 #include <cstring>
 #include <iostream>
 
+#include "atoms.h"
 #include "client.h"
 #include "clientmanager.h"
 #include "command.h"
+#include "decoration.h"
 #include "ewmh.h"
 #include "frametree.h"
 #include "globals.h"
@@ -24,6 +27,7 @@
 #include "ipc-server.h"
 #include "keymanager.h"
 #include "layout.h"
+#include "monitor.h"
 #include "monitormanager.h"
 #include "mousemanager.h"
 #include "rectangle.h"
@@ -33,6 +37,7 @@
 #include "settings.h"
 #include "stack.h"
 #include "tagmanager.h"
+#include "timer.h"
 #include "tmp.h"
 #include "utils.h"
 #include "xconnection.h"
@@ -217,6 +222,7 @@ unique_ptr<CommandTable> commands(shared_ptr<Root> root) {
         {"remove_attr",    { root_commands, &RootCommands::remove_attr_cmd,
                                             &RootCommands::remove_attr_complete }},
         {"compare",        BIND_OBJECT(root_commands, compare_cmd) },
+        {"source",         BIND_OBJECT(root_commands, source_cmd) },
         {"getenv",         getenv_command},
         {"setenv",         setenv_command},
         {"unsetenv",       unsetenv_command},
@@ -321,17 +327,16 @@ int load_command(int argc, char** argv, Output output) {
     (void) layout_string;
     assert(tag != nullptr);
     const char* rest = "To be implemented...";
-    tag_set_flags_dirty(); // we probably changed some window positions
     // arrange monitor
     Monitor* m = find_monitor_with_tag(tag);
     if (m) {
-        tag->frame->root_->setVisibleRecursive(true);
+        tag->setVisible(true);
         if (get_current_monitor() == m) {
             frame_focus_recursive(tag->frame->root_);
         }
         m->applyLayout();
     } else {
-        tag->frame->root_->setVisibleRecursive(false);
+        tag->setVisible(false);
     }
     if (!rest) {
         output << argv[0] << ": Error while parsing!\n";
@@ -356,7 +361,6 @@ int print_tag_status_command(int argc, char** argv, Output output) {
         output << argv[0] << ": Monitor \"" << argv[1] << "\" not found!\n";
         return HERBST_INVALID_ARGUMENT;
     }
-    tag_update_flags();
     output << '\t';
     for (int i = 0; i < tag_get_count(); i++) {
         HSTag* tag = get_tag_by_index(i);
@@ -717,7 +721,6 @@ static struct {
     void (*init)();
     void (*destroy)();
 } g_modules[] = {
-    { clientlist_init,  clientlist_destroy  },
     { ewmh_init,        ewmh_destroy        },
     { hook_init,        hook_destroy        },
 };
@@ -778,22 +781,64 @@ void destroynotify(Root* root, XEvent* event) {
     if (client) cm->force_unmanage(client);
 }
 
+static void focus_follows_mouse(Client* c) {
+    shared_ptr<HSFrameLeaf> target;
+    if (c->tag()->floating == false
+          && (target = c->tag()->frame->root_->frameWithClient(c))
+          && target->getLayout() == LAYOUT_MAX
+          && target->focusedClient() != c) {
+        // don't allow focus_follows_mouse if another window would be
+        // hidden during that focus change (which only occurs in max layout)
+        return;
+    }
+    focus_client(c, false, true);
+}
+
+// the window entered last, which is focused once the pointer rested on it
+// for focus_follows_mouse_delay milliseconds
+static Window g_enter_focus_window = 0;
+
+static void enternotify_commit_focus() {
+    Client* c = get_client_from_window(g_enter_focus_window);
+    g_enter_focus_window = 0;
+    if (c && !mouse_is_dragging() && g_settings->focus_follows_mouse()) {
+        focus_follows_mouse(c);
+    }
+}
+
+static Timer g_enter_focus_timer(enternotify_commit_focus);
+
 void enternotify(Root* root, XEvent* event) {
     XCrossingEvent *ce = &event->xcrossing;
     //HSDebug("name is: EnterNotify, focus = %d\n", event->xcrossing.focus);
+    if (enternotify_is_dropped(ce)) {
+        return;
+    }
     if (!mouse_is_dragging()
         && root->settings()->focus_follows_mouse()
         && ce->focus == false) {
         Client* c = get_client_from_window(ce->window);
-        shared_ptr<HSFrameLeaf> target;
-        if (c && c->tag()->floating == false
-              && (target = c->tag()->frame->root_->frameWithClient(c))
-              && target->getLayout() == LAYOUT_MAX
-              && target->focusedClient() != c) {
-            // don't allow focus_follows_mouse if another window would be
-            // hidden during that focus change (which only occurs in max layout)
-        } else if (c) {
-            focus_client(c, false, true);
+        int delay = root->settings()->focus_follows_mouse_delay();
+        if (delay <= 0) {
+            if (c) {
+                focus_follows_mouse(c);
+            }
+            return;
+        }
+        if (!c) {
+            // the pointer left the pending window, unless it only moved
+            // onto the window's decoration
+            Client* owner = Decoration::toClient(ce->window);
+            if (!owner || owner->window_ != g_enter_focus_window) {
+                g_enter_focus_window = 0;
+                g_enter_focus_timer.stop();
+            }
+        } else if (c == get_current_client()) {
+            g_enter_focus_window = 0;
+            g_enter_focus_timer.stop();
+        } else {
+            g_enter_focus_window = c->window_;
+            g_enter_focus_timer.start(delay);
         }
     }
 }
@@ -818,8 +863,8 @@ void mappingnotify(Root* root, XEvent* event) {
         // regrab when keyboard map changes
         XMappingEvent *ev = &event->xmapping;
         XRefreshKeyboardMapping(ev);
-        if(ev->request == MappingKeyboard) {
-            root->keys()->regrabAll();
+        if (ev->request == MappingKeyboard || ev->request == MappingModifier) {
+            root->keys()->updateKeyboardMapping();
             //TODO: mouse_regrab_all();
         }
     }
@@ -930,6 +975,8 @@ int main(int argc, char* argv[]) {
 
 
     // initialize subsystems
+    // the modules rely on the atoms, which need no cleanup
+    atoms_init();
     for (unsigned i = 0; i < LENGTH(g_modules); i++) {
         g_modules[i].init();
     }
@@ -937,7 +984,6 @@ int main(int argc, char* argv[]) {
     // setup
     root->monitors()->ensure_monitors_are_available();
     scan(&* root);
-    tag_force_update_flags();
     all_monitors_apply_layout();
     ewmh_update_all();
     execute_autostart_file();
@@ -950,11 +996,17 @@ int main(int argc, char* argv[]) {
     while (!g_aboutToQuit) {
         FD_ZERO(&in_fds);
         FD_SET(x11_fd, &in_fds);
-        // wait for an event or a signal
-        select(x11_fd + 1, &in_fds, nullptr, nullptr, nullptr);
+        // wait for an event, a signal or the next timer
+        long timeout_ms = Timer::msecsUntilNext();
+        struct timeval timeout;
+        timeout.tv_sec = timeout_ms / 1000;
+        timeout.tv_usec = (timeout_ms % 1000) * 1000;
+        select(x11_fd + 1, &in_fds, nullptr, nullptr,
+               (timeout_ms >= 0) ? &timeout : nullptr);
         if (g_aboutToQuit) {
             break;
         }
+        Timer::fireExpired();
         XSync(g_display, False);
         while (XQLength(g_display)) {
             XNextEvent(g_display, &event);
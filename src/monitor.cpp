@@ -139,6 +139,7 @@ void Monitor::applyLayout() {
     cur_rect.width -= (pad_left() + pad_right());
     cur_rect.y += pad_up();
     cur_rect.height -= (pad_up() + pad_down());
+    Rectangle padded_rect = cur_rect;
     if (!g_settings->smart_frame_surroundings() || tag->frame->root_->isSplit()) {
         // apply frame gap
         cur_rect.x += settings->frame_gap();
@@ -151,18 +152,31 @@ void Monitor::applyLayout() {
     if (isFocused) {
         frame_focus_recursive(tag->frame->root_);
     }
-    TilingResult res = tag->frame->root_->computeLayout(cur_rect);
+    TilingResult res;
+    res.reserve(tag->client_count(), tag->frame_count());
+    tag->frame->root_->computeLayout(cur_rect, layout_settings(settings), res);
     if (tag->floating) {
         for (auto& p : res.data) {
             p.second.floated = true;
         }
     }
+    if (tag->hasContainer()) {
+        // keep the pads free for panels unless a client is fullscreen
+        bool fullscreen = false;
+        for (auto& p : res.data) {
+            fullscreen = fullscreen || p.first->fullscreen_();
+        }
+        tag->setContainerArea(fullscreen ? rect : padded_rect);
+    }
     for (auto& p : res.data) {
         Client* c = p.first;
         if (c->fullscreen_()) {
             c->resize_fullscreen(rect, res.focus == c && isFocused);
         } else if (p.second.floated) {
             c->resize_floating(this, res.focus == c && isFocused);
+        } else if (p.second.hidden && c->isTiledWithin(p.second.geometry)) {
+            // the client is covered by the selected client of its max
+            // frame, so it is only configured once it is selected
         } else {
             c->resize_tiling(p.second.geometry, res.focus == c && isFocused);
         }
@@ -229,7 +243,7 @@ int set_monitor_rects(const RectangleVec &templates) {
             return HERBST_TAG_IN_USE;
         }
         g_monitors->addMonitor(templates[i], tag);
-        tag->frame->root_->setVisibleRecursive(true);
+        tag->setVisible(true);
     }
     // remove monitors if there are too much
     while (i < g_monitors->size()) {
@@ -433,12 +447,12 @@ int monitor_set_tag(Monitor* monitor, HSTag* tag) {
     monitor->applyLayout();
     monitor->lock_frames = false;
     // then show them (should reduce flicker)
-    tag->frame->root_->setVisibleRecursive(true);
+    tag->setVisible(true);
     if (!monitor->tag->floating) {
         // monitor->tag->frame->root_->updateVisibility();
     }
     // 2. hide old tag
-    old_tag->frame->root_->setVisibleRecursive(false);
+    old_tag->setVisible(false);
     // focus window just has been shown
     // focus again to give input focus
     frame_focus_recursive(tag->frame->root_);
@@ -764,7 +778,9 @@ void monitor_restack(Monitor* monitor) {
 
 void Monitor::restack() {
     vector<Window> buf = {};
-    buf.push_back(stacking_window);
+    if (!tag->hasContainer()) {
+        buf.push_back(stacking_window);
+    }
     vector_append(buf, tag->stack->toWindowBuf(false));
     /* remove a focused fullscreen client */
     Client* client = tag->frame->root_->focusedClient();
@@ -775,6 +791,17 @@ void Monitor::restack() {
         buf.erase(std::remove(buf.begin(), buf.end(), win), buf.end());
     }
     XRestackWindows(g_display, buf.data(), buf.size());
+    if (tag->hasContainer()) {
+        // the tag's windows are stacked within the container, which itself
+        // is stacked below the monitor's stacking window. A focused
+        // fullscreen client raises the entire container.
+        if (client && client->fullscreen_) {
+            XRaiseWindow(g_display, tag->containerWindow());
+        } else {
+            Window windows[] = { stacking_window, tag->containerWindow() };
+            XRestackWindows(g_display, windows, LENGTH(windows));
+        }
+    }
 }
 
 int shift_to_monitor(int argc, char** argv, Output output) {
@@ -799,10 +826,18 @@ void all_monitors_replace_previous_tag(HSTag *old, HSTag *newmon) {
     }
 }
 
+// EnterNotify events with a smaller serial were caused by our own requests
+static unsigned long g_enternotify_min_serial = 0;
+
 void drop_enternotify_events() {
-    XEvent ev;
-    XSync(g_display, False);
-    while(XCheckMaskEvent(g_display, EnterWindowMask, &ev));
+    // instead of waiting for the X server to process all requests so far,
+    // remember the serial of the next request: every EnterNotify caused by
+    // an earlier request has a smaller serial
+    g_enternotify_min_serial = NextRequest(g_display);
+}
+
+bool enternotify_is_dropped(const XCrossingEvent* ev) {
+    return ev->serial < g_enternotify_min_serial;
 }
 
 Rectangle Monitor::getFloatingArea() {
@@ -2,6 +2,7 @@
 #define __HERBSTLUFT_MONITOR_H_
 
 #include <X11/X.h>
+#include <X11/Xlib.h>
 
 #include "attribute_.h"
 #include "object.h"
@@ -82,7 +83,9 @@ void all_monitors_apply_layout();
 void ensure_monitors_are_available();
 void all_monitors_replace_previous_tag(HSTag* old, HSTag* newmon);
 
+// ignore all EnterNotify events caused by the requests sent so far
 void drop_enternotify_events();
+bool enternotify_is_dropped(const XCrossingEvent* ev);
 
 Stack* get_monitor_stack();
 
@@ -60,7 +60,7 @@ void MonitorManager::ensure_monitors_are_available() {
     HSTag* tag = tags_->ensure_tags_are_available();
     // add monitor with first tag
     Monitor* m = addMonitor(rect, tag);
-    m->tag->frame->root_->setVisibleRecursive(true);
+    m->tag->setVisible(true);
     cur_monitor = 0;
 
     monitor_update_focus_objects();
@@ -210,7 +210,7 @@ void MonitorManager::removeMonitor(Monitor* monitor)
     // Hide all clients visible in monitor
     assert(monitor->tag != nullptr);
     assert(monitor->tag->frame->root_ != nullptr);
-    monitor->tag->frame->root_->setVisibleRecursive(false);
+    monitor->tag->setVisible(false);
 
     g_monitors->removeIndexed(monitorIdx);
 
@@ -268,7 +268,7 @@ int MonitorManager::addMonitor(Input input, Output output)
     }
 
     monitor->applyLayout();
-    tag->frame->root_->setVisibleRecursive(true);
+    tag->setVisible(true);
     emit_tag_changed(tag, g_monitors->size() - 1);
     drop_enternotify_events();
 
@@ -1,8 +1,13 @@
 #include "mouse.h"
 
 #include <X11/X.h>
+#include <algorithm>
+#include <chrono>
+#include <climits>
 #include <cstdlib>
 #include <cstring>
+#include <set>
+#include <utility>
 
 #include "client.h"
 #include "command.h"
@@ -15,11 +20,16 @@
 #include "root.h"
 #include "settings.h"
 #include "tag.h"
+#include "timer.h"
 #include "utils.h"
 #include "x11-utils.h"
 
+using std::pair;
 using std::string;
 using std::vector;
+using std::chrono::duration_cast;
+using std::chrono::microseconds;
+using std::chrono::milliseconds;
 
 static Point2D          g_button_drag_start;
 static Rectangle        g_win_drag_start;
@@ -27,6 +37,64 @@ static Client*        g_win_drag_client = nullptr;
 static Monitor*       g_drag_monitor = nullptr;
 static MouseDragFunction g_drag_function = nullptr;
 
+/* the edges the dragged client can snap to, captured once when the drag
+ * starts, such that each motion event only needs a binary search per edge
+ */
+class SnapEdges {
+public:
+    struct Edge {
+        int pos;        // coordinate of the edge
+        int low, high;  // the interval [low, high) covered by the edge
+        int order;      // position of the client in the tag
+    };
+    // the vector to snap something to one of the edges
+    struct Snap {
+        int delta;
+        int order;
+        int sub;        // distinguishes snaps to edges of the same client
+        bool betterThan(const Snap& other) const {
+            if (abs(delta) != abs(other.delta)) {
+                return abs(delta) < abs(other.delta);
+            }
+            return order < other.order
+                || (order == other.order && sub < other.sub);
+        }
+    };
+    enum {
+        LeftEdges,      // left edges of other clients, for SNAP_EDGE_RIGHT
+        RightEdges,     // right edges of other clients, for SNAP_EDGE_LEFT
+        TopEdges,       // top edges of other clients, for SNAP_EDGE_BOTTOM
+        BottomEdges,    // bottom edges of other clients, for SNAP_EDGE_TOP
+        EdgeTypeCount,
+    };
+    void capture(Client* dragged, HSTag* tag);
+    void clear();
+    /** snap the coordinate x whose edge covers [low, high) to the edges of
+     * the given type, if this is better than the given snap
+     */
+    void snap(int edgeType, int x, int low, int high, int distance,
+              int sub, Snap* best) const;
+private:
+    vector<Edge> edges_[EdgeTypeCount];
+};
+
+static SnapEdges g_snap_edges;
+
+/* motion events are not applied immediately but at most drag_update_rate
+ * times per second, always using the newest motion event
+ */
+static void drag_apply_pending_motion();
+static void drag_settle();
+static XMotionEvent     g_drag_motion;
+static bool             g_drag_motion_pending = false;
+// when the oldest motion event that is not yet applied arrived
+static Timer::Clock::time_point g_drag_motion_arrival;
+static Timer::Clock::time_point g_drag_last_update;
+static Timer            g_drag_update_timer(drag_apply_pending_motion);
+// repaint the decoration if the pointer rests for this many milliseconds
+#define DRAG_SETTLE_DELAY 100
+static Timer            g_drag_settle_timer(drag_settle);
+
 #define CLEANMASK(mask)         ((mask) & ~(numlockMask|LockMask))
 #define REMOVEBUTTONMASK(mask) ((mask) & \
     ~( Button1Mask \
@@ -91,6 +159,10 @@ void mouse_initiate_drag(Client* client, MouseDragFunction function) {
     }
     g_win_drag_client->set_dragged( true);
     g_win_drag_start = g_win_drag_client->float_size_;
+    g_drag_motion_pending = false;
+    g_drag_last_update = Timer::Clock::time_point();
+    Root::get()->mouse->resetDragStatistics();
+    g_snap_edges.capture(client, client->tag());
     g_button_drag_start = get_cursor_position();
     XGrabPointer(g_display, client->x11Window(), True,
         PointerMotionMask|ButtonReleaseMask, GrabModeAsync,
@@ -98,6 +170,10 @@ void mouse_initiate_drag(Client* client, MouseDragFunction function) {
 }
 
 void mouse_stop_drag() {
+    // apply the last position before leaving the drag
+    drag_apply_pending_motion();
+    g_drag_update_timer.stop();
+    g_drag_settle_timer.stop();
     if (g_win_drag_client) {
         g_win_drag_client->set_dragged(false);
         // resend last size
@@ -105,12 +181,11 @@ void mouse_stop_drag() {
     }
     g_win_drag_client = nullptr;
     g_drag_function = nullptr;
+    g_snap_edges.clear();
     XUngrabPointer(g_display, CurrentTime);
-    // remove all enternotify-events from the event queue that were
-    // generated by the XUngrabPointer
-    XEvent ev;
-    XSync(g_display, False);
-    while(XCheckMaskEvent(g_display, EnterWindowMask, &ev));
+    // ignore all enternotify-events that were generated by the
+    // XUngrabPointer
+    drop_enternotify_events();
 }
 
 void handle_motion_event(XEvent* ev) {
@@ -120,8 +195,44 @@ void handle_motion_event(XEvent* ev) {
     if (ev->type != MotionNotify) return;
     // get newest motion notification
     while (XCheckMaskEvent(g_display, ButtonMotionMask, ev));
-    // call function that handles it
-    g_drag_function(&(ev->xmotion));
+    auto now = Timer::Clock::now();
+    if (!g_drag_motion_pending) {
+        g_drag_motion_arrival = now;
+    }
+    g_drag_motion = ev->xmotion;
+    g_drag_motion_pending = true;
+    int rate = g_settings->drag_update_rate();
+    if (rate <= 0) {
+        drag_apply_pending_motion();
+        return;
+    }
+    long interval = 1000 / rate;
+    long elapsed = duration_cast<milliseconds>(
+                        now - g_drag_last_update).count();
+    if (elapsed >= interval) {
+        drag_apply_pending_motion();
+    } else if (!g_drag_update_timer.active()) {
+        g_drag_update_timer.start(interval - elapsed);
+    }
+}
+
+static void drag_apply_pending_motion() {
+    if (!g_drag_motion_pending || !g_drag_function || !g_win_drag_client) {
+        return;
+    }
+    g_drag_motion_pending = false;
+    g_drag_function(&g_drag_motion);
+    g_drag_last_update = Timer::Clock::now();
+    Root::get()->mouse->recordDragUpdate(
+        duration_cast<microseconds>(
+            g_drag_last_update - g_drag_motion_arrival));
+    g_drag_settle_timer.start(DRAG_SETTLE_DELAY);
+}
+
+static void drag_settle() {
+    if (g_win_drag_client) {
+        g_win_drag_client->dec.redraw();
+    }
 }
 
 bool mouse_is_dragging() {
@@ -130,10 +241,7 @@ bool mouse_is_dragging() {
 
 int mouse_unbind_all() {
     Root::get()->mouse->binds.clear();
-    Client* client = get_current_client();
-    if (client) {
-        grab_client_buttons(client, true);
-    }
+    Root::get()->mouse->grabFocusedClient();
     return 0;
 }
 
@@ -209,30 +317,53 @@ std::experimental::optional<MouseBinding> mouse_binding_find(unsigned int modifi
     }
 }
 
-static void grab_client_button(MouseBinding* bind, Client* client) {
-    unsigned int numlockMask = Root::get()->keys()->getNumlockMask();
-    unsigned int modifiers[] = { 0, LockMask, numlockMask, numlockMask | LockMask };
-    for(int j = 0; j < LENGTH(modifiers); j++) {
-        XGrabButton(g_display, bind->button,
-                    bind->modifiers | modifiers[j],
-                    client->x11Window(), False, ButtonPressMask | ButtonReleaseMask,
-                    GrabModeAsync, GrabModeSync, None, None);
-    }
-}
-
+/*!
+ * Grabs the buttons of a client for click-to-focus and, if the client is
+ * focused, for the mouse bindings. The grabs present on the window are
+ * remembered in the client, so only the difference to the previous call is
+ * sent to the X server.
+ */
 void grab_client_buttons(Client* client, bool focused) {
-    XUngrabButton(g_display, AnyButton, AnyModifier, client->x11Window());
+    Window window = client->x11Window();
+    unsigned int btns[] = { Button1, Button2, Button3 };
+    if (!client->clickGrabbed_) {
+        XUngrabButton(g_display, AnyButton, AnyModifier, window);
+        for (int i = 0; i < LENGTH(btns); i++) {
+            XGrabButton(g_display, btns[i], AnyModifier, window, False,
+                        ButtonPressMask|ButtonReleaseMask, GrabModeSync,
+                        GrabModeSync, None, None);
+        }
+        client->clickGrabbed_ = true;
+        client->bindingGrabs_.clear();
+    }
+    // The click grabs on Button1 to Button3 with AnyModifier replace any
+    // grab of a binding on these buttons, so only bindings on other buttons
+    // need grabs of their own.
+    std::set<pair<unsigned int, unsigned int>> wanted;
     if (focused) {
+        auto lockCombinations = Root::get()->keys()->lockModifierCombinations();
         for (auto& bind : Root::get()->mouse->binds) {
-            grab_client_button(&bind, client);
+            if (std::find(btns, btns + LENGTH(btns), bind.button) != btns + LENGTH(btns)) {
+                continue;
+            }
+            for (auto lockModifiers : lockCombinations) {
+                wanted.insert({bind.button, bind.modifiers | lockModifiers});
+            }
         }
     }
-    unsigned int btns[] = { Button1, Button2, Button3 };
-    for (int i = 0; i < LENGTH(btns); i++) {
-        XGrabButton(g_display, btns[i], AnyModifier, client->x11Window(), False,
-                    ButtonPressMask|ButtonReleaseMask, GrabModeSync,
-                    GrabModeSync, None, None);
+    for (auto& grab : client->bindingGrabs_) {
+        if (!wanted.count(grab)) {
+            XUngrabButton(g_display, grab.first, grab.second, window);
+        }
     }
+    for (auto& grab : wanted) {
+        if (!client->bindingGrabs_.count(grab)) {
+            XGrabButton(g_display, grab.first, grab.second, window, False,
+                        ButtonPressMask | ButtonReleaseMask,
+                        GrabModeAsync, GrabModeSync, None, None);
+        }
+    }
+    client->bindingGrabs_ = wanted;
 }
 
 void mouse_function_move(XMotionEvent* me) {
@@ -363,68 +494,65 @@ void mouse_function_zoom(XMotionEvent* me) {
     g_win_drag_client->resize_floating(g_drag_monitor, get_current_client() == g_win_drag_client);
 }
 
-struct SnapData {
-    Client*       client;
-    Rectangle      rect;
-    enum SnapFlags  flags;
-    int             dx, dy; // the vector from client to other to make them snap
-};
-
 bool is_point_between(int point, int left, int right) {
     return (point < right && point >= left);
 }
 
-// compute vector to snap a point to an edge
-static void snap_1d(int x, int edge, int* delta) {
-    // whats the vector from subject to edge?
-    int cur_delta = edge - x;
-    // if distance is smaller then all other deltas
-    if (abs(cur_delta) < abs(*delta)) {
-        // then snap it, i.e. save vector
-        *delta = cur_delta;
+void SnapEdges::capture(Client* dragged, HSTag* tag) {
+    clear();
+    int gap = g_settings->snap_gap();
+    int order = 0;
+    tag->frame->root_->foreachClient([&](Client* c) {
+        if (c == dragged) {
+            return;
+        }
+        auto other = c->dec.last_outer();
+        // increase other by snap gap
+        other.x -= gap;
+        other.y -= gap;
+        other.width += gap * 2;
+        other.height += gap * 2;
+        int right = other.x + other.width;
+        int bottom = other.y + other.height;
+        edges_[LeftEdges].push_back({other.x, other.y, bottom, order});
+        edges_[RightEdges].push_back({right, other.y, bottom, order});
+        edges_[TopEdges].push_back({other.y, other.x, right, order});
+        edges_[BottomEdges].push_back({bottom, other.x, right, order});
+        order++;
+    });
+    for (auto& edges : edges_) {
+        std::sort(edges.begin(), edges.end(),
+            [](const Edge& a, const Edge& b) { return a.pos < b.pos; });
     }
 }
 
-static void client_snap_helper(Client* candidate, struct SnapData* d) {
-    if (candidate == d->client) {
-        return;
-    }
-    auto subject  = d->rect;
-    auto other    = candidate->dec.last_outer();
-    // increase other by snap gap
-    other.x -= g_settings->snap_gap();
-    other.y -= g_settings->snap_gap();
-    other.width += g_settings->snap_gap() * 2;
-    other.height += g_settings->snap_gap() * 2;
-    if (intervals_intersect(other.y, other.y + other.height, subject.y, subject.y + subject.height)) {
-        // check if x can snap to the right
-        if (d->flags & SNAP_EDGE_RIGHT) {
-            snap_1d(subject.x + subject.width, other.x, &d->dx);
-        }
-        // or to the left
-        if (d->flags & SNAP_EDGE_LEFT) {
-            snap_1d(subject.x, other.x + other.width, &d->dx);
-        }
+void SnapEdges::clear() {
+    for (auto& edges : edges_) {
+        edges.clear();
     }
-    if (intervals_intersect(other.x, other.x + other.width, subject.x, subject.x + subject.width)) {
-        // if we can snap to the top
-        if (d->flags & SNAP_EDGE_TOP) {
-            snap_1d(subject.y, other.y + other.height, &d->dy);
+}
+
+void SnapEdges::snap(int edgeType, int x, int low, int high, int distance,
+                     int sub, Snap* best) const {
+    auto& edges = edges_[edgeType];
+    // only edges closer than distance can snap
+    auto it = std::lower_bound(edges.begin(), edges.end(), x - distance + 1,
+        [](const Edge& e, int pos) { return e.pos < pos; });
+    for (; it != edges.end() && it->pos < x + distance; it++) {
+        if (!intervals_intersect(it->low, it->high, low, high)) {
+            continue;
         }
-        // or to the bottom
-        if (d->flags & SNAP_EDGE_BOTTOM) {
-            snap_1d(subject.y + subject.height, other.y, &d->dy);
+        Snap candidate = { it->pos - x, it->order, sub };
+        if (candidate.betterThan(*best)) {
+            *best = candidate;
         }
     }
-    return;
 }
 
 // get the vector to snap a client to it's neighbour
 void client_snap_vector(Client* client, Monitor* monitor,
                         enum SnapFlags flags,
                         int* return_dx, int* return_dy) {
-    struct SnapData d;
-    HSTag* tag = monitor->tag;
     int distance = std::max(0, g_settings->snap_distance());
     // init delta
     *return_dx = 0;
@@ -433,39 +561,62 @@ void client_snap_vector(Client* client, Monitor* monitor,
         // nothing to do
         return;
     }
-    d.client    = client;
     // translate client rectangle to global coordinates
-    d.rect      = client->outer_floating_rect();
-    d.rect.x += monitor->rect.x + monitor->pad_left;
-    d.rect.y += monitor->rect.y + monitor->pad_up;
-    d.flags     = flags;
-    d.dx        = distance;
-    d.dy        = distance;
+    auto rect = client->outer_floating_rect();
+    rect.x += monitor->rect.x + monitor->pad_left;
+    rect.y += monitor->rect.y + monitor->pad_up;
+    int right = rect.x + rect.width;
+    int bottom = rect.y + rect.height;
+    // on equal distance, prefer monitor edges over client edges, and
+    // earlier clients over later ones
+    SnapEdges::Snap dx = { distance, INT_MIN, 0 };
+    SnapEdges::Snap dy = { distance, INT_MIN, 0 };
+    auto snap_1d = [distance](int x, int edge, int sub, SnapEdges::Snap* best) {
+        SnapEdges::Snap candidate = { edge - x, -1, sub };
+        if (abs(candidate.delta) < distance && candidate.betterThan(*best)) {
+            *best = candidate;
+        }
+    };
 
     // snap to monitor edges
     Monitor* m = g_drag_monitor;
+    int gap = g_settings->snap_gap();
     if (flags & SNAP_EDGE_TOP) {
-        snap_1d(d.rect.y, m->rect.y + m->pad_up + g_settings->snap_gap(), &d.dy);
+        snap_1d(rect.y, m->rect.y + m->pad_up + gap, 0, &dy);
     }
     if (flags & SNAP_EDGE_LEFT) {
-        snap_1d(d.rect.x, m->rect.x + m->pad_left + g_settings->snap_gap(), &d.dx);
+        snap_1d(rect.x, m->rect.x + m->pad_left + gap, 0, &dx);
     }
     if (flags & SNAP_EDGE_RIGHT) {
-        snap_1d(d.rect.x + d.rect.width, m->rect.x + m->rect.width - m->pad_right - g_settings->snap_gap(), &d.dx);
+        snap_1d(right, m->rect.x + m->rect.width - m->pad_right - gap, 1, &dx);
     }
     if (flags & SNAP_EDGE_BOTTOM) {
-        snap_1d(d.rect.y + d.rect.height, m->rect.y + m->rect.height - m->pad_down - g_settings->snap_gap(), &d.dy);
+        snap_1d(bottom, m->rect.y + m->rect.height - m->pad_down - gap, 1, &dy);
     }
 
     // snap to other clients
-    tag->frame->root_->foreachClient([&d] (Client* c) { client_snap_helper(c, &d); });
+    if (flags & SNAP_EDGE_RIGHT) {
+        g_snap_edges.snap(SnapEdges::LeftEdges, right, rect.y, bottom,
+                          distance, 0, &dx);
+    }
+    if (flags & SNAP_EDGE_LEFT) {
+        g_snap_edges.snap(SnapEdges::RightEdges, rect.x, rect.y, bottom,
+                          distance, 1, &dx);
+    }
+    if (flags & SNAP_EDGE_TOP) {
+        g_snap_edges.snap(SnapEdges::BottomEdges, rect.y, rect.x, right,
+                          distance, 0, &dy);
+    }
+    if (flags & SNAP_EDGE_BOTTOM) {
+        g_snap_edges.snap(SnapEdges::TopEdges, bottom, rect.x, right,
+                          distance, 1, &dy);
+    }
 
     // write back results
-    if (abs(d.dx) < abs(distance)) {
-        *return_dx = d.dx;
+    if (abs(dx.delta) < distance) {
+        *return_dx = dx.delta;
     }
-    if (abs(d.dy) < abs(distance)) {
-        *return_dy = d.dy;
+    if (abs(dy.delta) < distance) {
+        *return_dy = dy.delta;
     }
 }
-
@@ -2,6 +2,7 @@
 
 #include <X11/Xlib.h>
 #include <X11/cursorfont.h>
+#include <algorithm>
 #include <initializer_list>
 #include <ostream>
 #include <set>
@@ -20,8 +21,15 @@
 using std::vector;
 using std::string;
 using std::endl;
-
-MouseManager::MouseManager() {
+using std::chrono::microseconds;
+
+MouseManager::MouseManager()
+    : drag_updates(this, "drag_updates", [this] { return dragUpdates_; })
+    , drag_latency_avg(this, "drag_latency_avg", [this] {
+        return dragUpdates_ ? dragLatencySum_ / dragUpdates_ : 0;
+    })
+    , drag_latency_max(this, "drag_latency_max", [this] { return dragLatencyMax_; })
+{
     /* set cursor theme */
     cursor = XCreateFontCursor(g_display, XC_left_ptr);
     XDefineCursor(g_display, g_root, cursor);
@@ -31,6 +39,19 @@ MouseManager::~MouseManager() {
     XFreeCursor(g_display, cursor);
 }
 
+void MouseManager::resetDragStatistics() {
+    dragUpdates_ = 0;
+    dragLatencySum_ = 0;
+    dragLatencyMax_ = 0;
+}
+
+void MouseManager::recordDragUpdate(microseconds latency) {
+    unsigned long usecs = std::max(0l, (long)latency.count());
+    dragUpdates_++;
+    dragLatencySum_ += usecs;
+    dragLatencyMax_ = std::max(dragLatencyMax_, usecs);
+}
+
 int MouseManager::addMouseBindCommand(Input input, Output output) {
     if (input.size() < 2) {
         return HERBST_NEED_MORE_ARGS;
@@ -78,10 +99,7 @@ int MouseManager::addMouseBindCommand(Input input, Output output) {
     mb.action = action;
     mb.cmd = cmd;
     binds.push_front(mb);
-    Client* client = get_current_client();
-    if (client) {
-        grab_client_buttons(client, true);
-    }
+    grabFocusedClient();
 
     return HERBST_EXIT_SUCCESS;
 }
@@ -148,3 +166,29 @@ void MouseManager::addMouseBindCompletion(Completion &complete) {
         complete.none();
     }
 }
+
+void MouseManager::grabFocusedClient() {
+    if (grabTransactionDepth_ > 0) {
+        grabsDirty_ = true;
+        return;
+    }
+    Client* client = get_current_client();
+    if (client) {
+        grab_client_buttons(client, true);
+    }
+}
+
+void MouseManager::beginGrabTransaction() {
+    grabTransactionDepth_++;
+}
+
+void MouseManager::endGrabTransaction() {
+    if (grabTransactionDepth_ <= 0) {
+        return;
+    }
+    grabTransactionDepth_--;
+    if (grabTransactionDepth_ == 0 && grabsDirty_) {
+        grabsDirty_ = false;
+        grabFocusedClient();
+    }
+}
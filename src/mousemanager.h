@@ -1,8 +1,10 @@
 #pragma once
 
 #include <X11/X.h>
+#include <chrono>
 #include <list>
 
+#include "attribute_.h"
 #include "mouse.h"
 #include "object.h"
 
@@ -17,9 +19,31 @@ public:
 
     void addMouseBindCompletion(Completion &complete);
 
+    //! grab the buttons of the focused client, or remember to do so at the
+    //! end of the current grab transaction
+    void grabFocusedClient();
+    //! see KeyManager::beginGrabTransaction()
+    void beginGrabTransaction();
+    void endGrabTransaction();
+
     //! Currently defined mouse bindings (TODO: make this private as soon as possible)
     std::list<MouseBinding> binds;
 
+    //! forget the statistics of the previous drag
+    void resetDragStatistics();
+    //! record a drag update that was applied the given time after the
+    //! corresponding motion event arrived
+    void recordDragUpdate(std::chrono::microseconds latency);
+
+    DynAttribute_<unsigned long> drag_updates;
+    DynAttribute_<unsigned long> drag_latency_avg;
+    DynAttribute_<unsigned long> drag_latency_max;
+
 private:
     Cursor cursor;
+    int grabTransactionDepth_ = 0;
+    bool grabsDirty_ = false;
+    unsigned long dragUpdates_ = 0;
+    unsigned long dragLatencySum_ = 0; // in microseconds
+    unsigned long dragLatencyMax_ = 0; // in microseconds
 };
@@ -49,6 +49,7 @@ Root::Root(Globals g, XConnection& xconnection)
     // inject dependencies where needed
     settings->injectDependencies(this);
     tags->injectDependencies(monitors(), settings());
+    keys->injectDependencies(settings());
     clients->injectDependencies(settings(), theme());
     monitors->injectDependencies(settings(), tags());
 
@@ -1,16 +1,22 @@
 #include "rootcommands.h"
 
 #include <algorithm>
+#include <cctype>
+#include <cerrno>
 #include <cstring>
+#include <fstream>
 #include <functional>
 #include <iostream>
 #include <map>
 #include <memory>
+#include <sstream>
 
 #include "attribute_.h"
 #include "command.h"
 #include "completion.h"
 #include "ipc-protocol.h"
+#include "keymanager.h"
+#include "mousemanager.h"
 #include "root.h"
 
 using std::endl;
@@ -426,3 +432,143 @@ void RootCommands::attr_complete(Completion& complete)
     }
 }
 
+
+/** split a line into arguments similar to a POSIX shell: arguments are
+ * separated by whitespace, quotes group words, a backslash escapes the next
+ * character and a # at the beginning of an argument starts a comment.
+ * Returns false on an unterminated quote or a trailing backslash.
+ */
+bool RootCommands::splitCommandLine(const string& line, vector<string>& args)
+{
+    args.clear();
+    string current;
+    bool inArgument = false;
+    char quote = '\0';
+    for (size_t i = 0; i < line.size(); i++) {
+        char c = line[i];
+        if (quote == '\'') {
+            if (c == '\'') {
+                quote = '\0';
+            } else {
+                current += c;
+            }
+        } else if (c == '\\') {
+            if (i + 1 >= line.size()) {
+                return false;
+            }
+            char next = line[++i];
+            // inside double quotes, the backslash only escapes " and itself
+            if (quote == '"' && next != '"' && next != '\\') {
+                current += c;
+            }
+            current += next;
+            inArgument = true;
+        } else if (quote == '"') {
+            if (c == '"') {
+                quote = '\0';
+            } else {
+                current += c;
+            }
+        } else if (c == '\'' || c == '"') {
+            quote = c;
+            inArgument = true;
+        } else if (isspace(static_cast<unsigned char>(c))) {
+            if (inArgument) {
+                args.push_back(current);
+                current.clear();
+                inArgument = false;
+            }
+        } else if (c == '#' && !inArgument) {
+            break;
+        } else {
+            current += c;
+            inArgument = true;
+        }
+    }
+    if (quote != '\0') {
+        return false;
+    }
+    if (inArgument) {
+        args.push_back(current);
+    }
+    return true;
+}
+
+// the maximal nesting depth of the source command
+static const int SOURCE_MAX_DEPTH = 8;
+
+//! whether the line ends with a backslash that is not escaped itself
+static bool continues_in_next_line(const string& line) {
+    size_t backslashes = 0;
+    for (auto it = line.rbegin(); it != line.rend() && *it == '\\'; it++) {
+        backslashes++;
+    }
+    return backslashes % 2 == 1;
+}
+
+int RootCommands::source_cmd(Input input, Output output)
+{
+    string path;
+    if (!(input >> path)) return HERBST_NEED_MORE_ARGS;
+    std::ifstream file(path);
+    if (!file) {
+        output << input.command() << ": Can not open \"" << path << "\": "
+               << strerror(errno) << endl;
+        return HERBST_INVALID_ARGUMENT;
+    }
+    // a file sourcing itself would recurse until the stack overflows
+    if (sourceDepth_ >= SOURCE_MAX_DEPTH) {
+        output << input.command() << ": \"" << path << "\": files are nested "
+               << "deeper than " << SOURCE_MAX_DEPTH << " levels" << endl;
+        return HERBST_FORBIDDEN;
+    }
+    sourceDepth_++;
+    // apply the grabs of all key and mouse bindings in the file at once
+    root->keys()->beginGrabTransaction();
+    root->mouse()->beginGrabTransaction();
+    int status = 0;
+    size_t lineNumber = 0;
+    string line;
+    vector<string> args;
+    while (std::getline(file, line)) {
+        lineNumber++;
+        size_t firstLine = lineNumber;
+        // join lines that end with a backslash
+        string next;
+        while (continues_in_next_line(line) && std::getline(file, next)) {
+            lineNumber++;
+            line.pop_back();
+            line += next;
+        }
+        if (!splitCommandLine(line, args)) {
+            output << path << ":" << firstLine << ": unterminated quote" << endl;
+            status = status ? status : HERBST_INVALID_ARGUMENT;
+            continue;
+        }
+        if (args.empty()) {
+            continue;
+        }
+        std::ostringstream commandOutput;
+        Input command(args[0], vector<string>(args.begin() + 1, args.end()));
+        int commandStatus = Commands::call(command, commandOutput);
+        if (commandStatus == 0) {
+            output << commandOutput.str();
+            continue;
+        }
+        status = status ? status : commandStatus;
+        string message = commandOutput.str();
+        if (message.empty()) {
+            output << path << ":" << firstLine << ": " << args[0]
+                   << " failed with exit status " << commandStatus << endl;
+        } else {
+            output << path << ":" << firstLine << ": " << message;
+            if (message.back() != '\n') {
+                output << endl;
+            }
+        }
+    }
+    root->mouse()->endGrabTransaction();
+    root->keys()->endGrabTransaction();
+    sourceDepth_--;
+    return status;
+}
@@ -6,6 +6,7 @@
 
 #include <functional>
 #include <memory>
+#include <string>
 #include <vector>
 
 #include "types.h"
@@ -42,6 +43,8 @@ public:
     int remove_attr_cmd(Input input, Output output);
     void remove_attr_complete(Completion& complete);
     int compare_cmd(Input input, Output output);
+    int source_cmd(Input input, Output output);
+    static bool splitCommandLine(const std::string& line, std::vector<std::string>& args);
     static Attribute* newAttributeWithType(std::string typestr, std::string attr_name, Output output);
     void completeObjectPath(Completion& complete, bool attributes = false,
                             std::function<bool(Attribute*)> attributeFilter = {});
@@ -49,6 +52,8 @@ public:
 private:
     Root* root;
     std::vector<std::unique_ptr<Attribute>> userAttributes_;
+    //! the number of source commands currently being executed
+    int sourceDepth_ = 0;
 };
 
 
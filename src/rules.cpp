@@ -1,10 +1,12 @@
 #include "rules.h"
 
 #include <X11/X.h>
+#include <X11/Xatom.h>
 #include <X11/Xlib.h>
 #include <algorithm>
 #include <cstdio>
 
+#include "atoms.h"
 #include "client.h"
 #include "ewmh.h"
 #include "globals.h"
@@ -246,7 +248,7 @@ bool Condition::matchesWindowtype(const Client* client) const {
             offset,
             bufsize,
             False,
-            ATOM("ATOM"),
+            XA_ATOM,
             &type_ret,
             &format,
             &items,
@@ -278,7 +280,7 @@ bool Condition::matchesWindowtype(const Client* client) const {
 
 bool Condition::matchesWindowrole(const Client* client) const {
     auto role = Root::get()->X.getWindowProperty(client->window_,
-        ATOM("WM_WINDOW_ROLE"));
+        g_atom[AtomWmWindowRole]);
 
     if (!role.has_value()) {
         return false;
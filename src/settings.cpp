@@ -62,6 +62,7 @@ Settings::Settings()
         &default_direction_external_only,
         &default_frame_layout,
         &focus_follows_mouse,
+        &focus_follows_mouse_delay,
         &focus_stealing_prevention,
         &swap_monitors_to_get_tag,
         &raise_on_focus,
@@ -74,6 +75,9 @@ Settings::Settings()
         &auto_detect_monitors,
         &pseudotile_center_threshold,
         &update_dragged_clients,
+        &drag_update_rate,
+        &tag_containers,
+        &xkb_ignore_lock_mods,
         &tree_style,
         &wmname,
 
@@ -119,6 +123,18 @@ Settings::Settings()
         }
         return string();
     });
+    drag_update_rate.setValidator([] (int rate) {
+        if (rate < 0) {
+            return string("drag_update_rate must not be negative");
+        }
+        return string();
+    });
+    focus_follows_mouse_delay.setValidator([] (int delay) {
+        if (delay < 0) {
+            return string("focus_follows_mouse_delay must not be negative");
+        }
+        return string();
+    });
     tree_style.setValidator([] (string new_value) {
         if (utf8_string_length(new_value) < 8) {
             return string("tree_style needs 8 characters");
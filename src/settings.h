@@ -50,6 +50,7 @@ public:
     Attribute_<bool>          default_direction_external_only = {"default_direction_external_only", false};
     Attribute_<unsigned long> default_frame_layout = {"default_frame_layout", 0};
     Attribute_<bool>          focus_follows_mouse = {"focus_follows_mouse", false};
+    Attribute_<int>           focus_follows_mouse_delay = {"focus_follows_mouse_delay", 0};
     Attribute_<bool>          focus_stealing_prevention = {"focus_stealing_prevention", true};
     Attribute_<bool>          swap_monitors_to_get_tag = {"swap_monitors_to_get_tag", true};
     Attribute_<bool>          raise_on_focus = {"raise_on_focus", false};
@@ -62,6 +63,9 @@ public:
     Attribute_<bool>          auto_detect_monitors = {"auto_detect_monitors", false};
     Attribute_<int>           pseudotile_center_threshold = {"pseudotile_center_threshold", 10};
     Attribute_<bool>          update_dragged_clients = {"update_dragged_clients", false};
+    Attribute_<int>           drag_update_rate = {"drag_update_rate", 60};
+    Attribute_<bool>          tag_containers = {"tag_containers", false};
+    Attribute_<bool>          xkb_ignore_lock_mods = {"xkb_ignore_lock_mods", false};
     Attribute_<string>        tree_style = {"tree_style", "*| +`--."};
     Attribute_<string>        wmname = {"wmname", WINDOW_MANAGER_NAME};
     // for compatibility
@@ -188,6 +188,11 @@ static vector<Window> slice_to_window_buf(Slice* s, bool real_clients, HSLayer l
             vector<Window> result;
             if (!real_clients) {
                 result.push_back(s->data.monitor->stacking_window);
+                if (tag->hasContainer()) {
+                    // the tag's windows are stacked within the container
+                    result.push_back(tag->containerWindow());
+                    return result;
+                }
             }
             vector_append(result, tag->stack->toWindowBuf(real_clients));
             return result;
@@ -1,5 +1,7 @@
 #include "tag.h"
 
+#include <X11/extensions/shape.h>
+#include <algorithm>
 #include <cstring>
 
 #include "client.h"
@@ -20,25 +22,32 @@ using std::make_shared;
 using std::shared_ptr;
 using std::string;
 
-static bool    g_tag_flags_dirty = true;
-
 HSTag::HSTag(string name_, Settings* settings)
     : index(this, "index", 0)
     , floating(this, "floating", false, [](bool){return "";})
     , name(this, "name", name_, &HSTag::validateNewName)
-    , frame_count(this, "frame_count", &HSTag::computeFrameCount)
-    , client_count(this, "client_count", &HSTag::computeClientCount)
+    , frame_count(this, "frame_count", 0)
+    , client_count(this, "client_count", 0)
     , curframe_windex(this, "curframe_windex",
         [this] () { return frame->focusedFrame()->getSelection(); } )
     , curframe_wcount(this, "curframe_wcount",
         [this] () { return frame->focusedFrame()->clientCount(); } )
+    , flags(0)
+    , settings_(settings)
 {
     stack = make_shared<Stack>();
+    if (settings->tag_containers()) {
+        // create it before the frame tree, which creates its windows in it
+        createContainer();
+    }
     frame = make_shared<FrameTree>(this, settings);
 }
 
 HSTag::~HSTag() {
     frame = {};
+    if (container_) {
+        XDestroyWindow(g_display, container_);
+    }
 }
 
 void HSTag::setIndexAttribute(unsigned long new_index) {
@@ -55,20 +64,98 @@ string HSTag::validateNewName(string newName) {
     return string();
 }
 
-int HSTag::computeFrameCount() {
-    int count = 0;
-    frame->root_->fmap([](HSFrameSplit*) {},
-                [&count](HSFrameLeaf*) { count++; },
-                0);
-    return count;
+void HSTag::frameCountChanged(int delta) {
+    if (delta != 0) {
+        frame_count = frame_count() + delta;
+    }
+}
+
+void HSTag::clientCountChanged(int delta) {
+    if (delta != 0) {
+        client_count = client_count() + delta;
+    }
+}
+
+Window HSTag::decorationParent() const {
+    return container_ ? container_ : g_root;
+}
+
+void HSTag::createContainer() {
+    XSetWindowAttributes at;
+    at.background_pixmap = ParentRelative;
+    at.override_redirect = True;
+    // the container covers the entire screen, even if the screen grows
+    // later on, and its shape restricts it to the area of the monitor
+    // showing this tag
+    container_ = XCreateWindow(g_display, g_root, 0, 0, 0x7fff, 0x7fff, 0,
+                               CopyFromParent, InputOutput, CopyFromParent,
+                               CWBackPixmap | CWOverrideRedirect, &at);
+    XShapeCombineRectangles(g_display, container_, ShapeBounding, 0, 0,
+                            nullptr, 0, ShapeSet, YXBanded);
+    containerArea_ = {0, 0, 0, 0};
+}
+
+void HSTag::setVisible(bool visible) {
+    if (container_ && !visible) {
+        XUnmapWindow(g_display, container_);
+    }
+    frame->root_->setVisibleRecursive(visible);
+    if (container_ && visible) {
+        // map the container last, such that all its windows appear at once
+        XMapWindow(g_display, container_);
+    }
 }
 
-int HSTag::computeClientCount() {
-    int count = 0;
-    frame->root_->fmap([](HSFrameSplit*) {},
-                [&count](HSFrameLeaf* l) { count += l->clientCount(); },
-                0);
-    return count;
+void HSTag::setContainerArea(Rectangle area) {
+    if (!container_
+        || (area.x == containerArea_.x && area.y == containerArea_.y
+            && area.width == containerArea_.width
+            && area.height == containerArea_.height)) {
+        return;
+    }
+    containerArea_ = area;
+    XRectangle rect = {
+        (short)area.x, (short)area.y,
+        (unsigned short)std::max(0, area.width),
+        (unsigned short)std::max(0, area.height),
+    };
+    XShapeCombineRectangles(g_display, container_, ShapeBounding, 0, 0,
+                            &rect, 1, ShapeSet, YXBanded);
+}
+
+void HSTag::updateContainer() {
+    if (settings_->tag_containers() == hasContainer()) {
+        return;
+    }
+    bool tagVisible = find_monitor_with_tag(this) != nullptr;
+    if (settings_->tag_containers()) {
+        createContainer();
+        reparentWindows(container_, tagVisible);
+        if (tagVisible) {
+            XMapWindow(g_display, container_);
+        }
+    } else {
+        Window container = container_;
+        container_ = 0;
+        reparentWindows(g_root, tagVisible);
+        XDestroyWindow(g_display, container);
+    }
+}
+
+void HSTag::reparentWindows(Window parent, bool tagVisible) {
+    bool hideFrames = !tagVisible && parent == g_root;
+    frame->root_->fmap(
+        [](HSFrameSplit*) {},
+        [parent,hideFrames](HSFrameLeaf* leaf) {
+            if (hideFrames) {
+                // only the container hides the frames of an invisible tag
+                leaf->getDecoration()->hide();
+            }
+            leaf->getDecoration()->setParent(parent);
+        }, 0);
+    frame->root_->foreachClient([parent](Client* client) {
+        client->setDecorationParent(parent);
+    });
 }
 
 int    tag_get_count() {
@@ -129,31 +216,39 @@ int tag_set_floating_command(int argc, char** argv, Output output) {
     return 0;
 }
 
-void tag_force_update_flags() {
-    g_tag_flags_dirty = false;
-    // unset all tags
-    for (auto t : *global_tags) {
-        t->flags = 0;
-    }
-    // update flags
-    for (auto c : Root::get()->clients()->clients()) {
-        auto client = c.second;
-        TAG_SET_FLAG(client->tag(), TAG_FLAG_USED);
-        if (client->urgent_) {
-            TAG_SET_FLAG(client->tag(), TAG_FLAG_URGENT);
-        }
+void HSTag::clientEntered(bool urgent) {
+    clientsOnTag_++;
+    if (urgent) {
+        urgentClients_++;
     }
+    updateFlags();
 }
 
-void tag_update_flags() {
-    if (g_tag_flags_dirty) {
-        tag_force_update_flags();
+void HSTag::clientLeft(bool urgent) {
+    clientsOnTag_--;
+    if (urgent) {
+        urgentClients_--;
     }
+    updateFlags();
+}
+
+void HSTag::urgentClientsChanged(int delta) {
+    urgentClients_ += delta;
+    updateFlags();
 }
 
-void tag_set_flags_dirty() {
-    g_tag_flags_dirty = true;
-    hook_emit_list("tag_flags", nullptr);
+void HSTag::updateFlags() {
+    int new_flags = 0;
+    if (clientsOnTag_ > 0) {
+        new_flags |= TAG_FLAG_USED;
+    }
+    if (urgentClients_ > 0) {
+        new_flags |= TAG_FLAG_URGENT;
+    }
+    if (new_flags != flags) {
+        flags = new_flags;
+        hook_emit_list("tag_flags", nullptr);
+    }
 }
 
 HSTag* find_tag_with_toplevel_frame(HSFrame* frame) {
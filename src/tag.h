@@ -5,9 +5,7 @@
 
 #include "attribute_.h"
 #include "object.h"
-
-#define TAG_SET_FLAG(tag, flag) \
-    ((tag)->flags |= (flag))
+#include "x11-types.h"
 
 enum {
     TAG_FLAG_URGENT = 0x01, // is there a urgent window?
@@ -26,18 +24,45 @@ public:
     Attribute_<unsigned long> index;
     Attribute_<bool>         floating;
     Attribute_<std::string>  name;   // name of this tag
-    DynAttribute_<int> frame_count;
-    DynAttribute_<int> client_count;
+    Attribute_<int>    frame_count; // maintained by the frame tree
+    Attribute_<int>    client_count; // maintained by the frame tree
     DynAttribute_<int> curframe_windex;
     DynAttribute_<int> curframe_wcount;
     int             flags;
     std::shared_ptr<Stack> stack;
     void setIndexAttribute(unsigned long new_index) override;
+    //! keep the flags up to date when a client enters or leaves this tag
+    void clientEntered(bool urgent);
+    void clientLeft(bool urgent);
+    //! keep the flags up to date when a client on this tag becomes urgent
+    //! (delta = 1) or not urgent anymore (delta = -1)
+    void urgentClientsChanged(int delta);
+    //! called by the frame tree when frames or clients are added or removed
+    void frameCountChanged(int delta);
+    void clientCountChanged(int delta);
+    //! the parent of the decoration and frame windows of this tag: the
+    //! container window if the setting tag_containers is on, and the root
+    //! window otherwise
+    Window decorationParent() const;
+    Window containerWindow() const { return container_; }
+    bool hasContainer() const { return container_ != 0; }
+    //! show or hide all windows of this tag
+    void setVisible(bool visible);
+    //! restrict the container window to the given area of the screen
+    void setContainerArea(Rectangle area);
+    //! create or remove the container window according to tag_containers
+    void updateContainer();
 private:
-    //! get the number of clients on this tag
-    int computeClientCount();
-    //! get the number of clients on this tag
-    int computeFrameCount();
+    void createContainer();
+    //! move all decoration and frame windows of this tag to the given parent
+    void reparentWindows(Window parent, bool tagVisible);
+    Settings* settings_;
+    Window container_ = 0;
+    Rectangle containerArea_ = {0, 0, 0, 0};
+    //! recompute the flags and emit the tag_flags hook if they changed
+    void updateFlags();
+    int clientsOnTag_ = 0; // number of clients whose tag() is this
+    int urgentClients_ = 0; // number of urgent clients among them
     //! check whether a name is valid and return error message otherwise
     std::string validateNewName(std::string newName);
 };
@@ -53,9 +78,6 @@ void tag_update_focus_layer(HSTag* tag);
 void tag_foreach(void (*action)(HSTag*,void*), void* data);
 void tag_update_each_focus_layer();
 void tag_update_focus_objects();
-void tag_force_update_flags();
-void tag_update_flags();
-void tag_set_flags_dirty();
 
 #endif
 
@@ -10,6 +10,7 @@
 #include "layout.h"
 #include "monitor.h"
 #include "monitormanager.h"
+#include "settings.h"
 #include "stack.h"
 #include "utils.h"
 
@@ -28,6 +29,17 @@ TagManager::TagManager()
 void TagManager::injectDependencies(MonitorManager* m, Settings *s) {
     monitors_ = m;
     settings_ = s;
+    settings_->tag_containers.changed().connect(this, &TagManager::updateTagContainers);
+}
+
+void TagManager::updateTagContainers() {
+    for (auto tag : *this) {
+        tag->updateContainer();
+    }
+    // the containers take the place of the tag windows in the stack
+    monitors_->monitor_stack->markDirty();
+    monitors_->monitor_stack->restack();
+    all_monitors_apply_layout();
 }
 
 HSTag* TagManager::find(const string& name) {
@@ -50,7 +62,6 @@ HSTag* TagManager::add_tag(const string& name) {
 
     ewmh_update_desktops();
     ewmh_update_desktop_names();
-    tag_set_flags_dirty();
     return tag;
 }
 
@@ -103,6 +114,7 @@ int TagManager::removeTag(Input input, Output output) {
 
     // Move clients to target tag
     for (auto client : clients) {
+        tagToRemove->frame->root_->removeClient(client);
         client->tag()->stack->removeSlice(client->slice);
         client->setTag(targetTag);
         client->tag()->stack->insertSlice(client->slice);
@@ -125,7 +137,6 @@ int TagManager::removeTag(Input input, Output output) {
     ewmh_update_current_desktop();
     ewmh_update_desktops();
     ewmh_update_desktop_names();
-    tag_set_flags_dirty();
     hook_emit_list("tag_removed", removedName.c_str(), targetTag->name->c_str(), nullptr);
 
     return HERBST_EXIT_SUCCESS;
@@ -239,7 +250,6 @@ void TagManager::moveClient(Client* client, HSTag* target) {
     else if (monitor_source == get_current_monitor()) {
         frame_focus_recursive(monitor_source->tag->frame->root_);
     }
-    tag_set_flags_dirty();
 }
 
 int TagManager::tag_move_window_command(Input argv, Output output) {
@@ -30,6 +30,8 @@ public:
     std::function<int(Input, Output)> frameCommand(FrameCommand cmd);
     std::function<int()> frameCommand(std::function<int(FrameTree&)> cmd);
 private:
+    //! create or remove the tag container windows after tag_containers changed
+    void updateTagContainers();
     ByName by_name_;
     MonitorManager* monitors_ = {}; // circular dependency
     Settings* settings_;
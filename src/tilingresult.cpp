@@ -6,15 +6,13 @@ TilingStep::TilingStep(Rectangle rect)
     : geometry(rect)
 { }
 
-TilingStep& TilingResult::operator[](Client* client) {
-    TilingStep someStep = Rectangle();
-    data.push_back(make_pair(client, someStep));
-    return data.rbegin()->second;
+void TilingResult::reserve(size_t clientCount, size_t frameCount) {
+    data.reserve(clientCount);
+    frames.reserve(frameCount);
 }
 
-void TilingResult::mergeFrom(TilingResult& other) {
-    data.splice(data.end(), other.data);
-    frames.splice(frames.end(), other.frames);
+void TilingResult::add(Client* client, const TilingStep& step) {
+    data.push_back(make_pair(client, step));
 }
 
 void TilingResult::add(FrameDecoration* dec, const FrameDecorationData& frame_data) {
@@ -1,7 +1,7 @@
 #ifndef __HLWM_TILINGSTEP_H_
 #define __HLWM_TILINGSTEP_H_
 
-#include <list>
+#include <vector>
 
 #include "framedecoration.h"
 #include "x11-types.h"
@@ -16,23 +16,24 @@ public:
     Rectangle geometry;
     bool floated = false;
     bool needsRaise = false;
+    bool hidden = false; // whether other clients of the frame cover it
 };
 
-// a tiling result contains the movement commands etc. for all clients
+// a tiling result contains the movement commands etc. for all clients. The
+// frame tree appends to a single tiling result while computing the layout,
+// so if enough space is reserved beforehand, no further allocations happen.
 class TilingResult {
 public:
     TilingResult() = default;
-    TilingStep& operator[](Client* client);
+    void reserve(size_t clientCount, size_t frameCount);
+    void add(Client* client, const TilingStep& step);
     void add(FrameDecoration* dec, const FrameDecorationData& frame_data);
 
     Client* focus = {}; // the focused client
     FrameDecoration* focused_frame = {};
 
-    // merge all the tiling steps from other into this
-    void mergeFrom(TilingResult& other);
-
-    std::list<std::pair<FrameDecoration*,FrameDecorationData>> frames;
-    std::list<std::pair<Client*,TilingStep>> data;
+    std::vector<std::pair<FrameDecoration*,FrameDecorationData>> frames;
+    std::vector<std::pair<Client*,TilingStep>> data;
 };
 
 
@@ -0,0 +1,73 @@
+#include "timer.h"
+
+#include <algorithm>
+#include <vector>
+
+using std::function;
+using std::vector;
+using std::chrono::duration_cast;
+using std::chrono::milliseconds;
+
+static vector<Timer*>& active_timers() {
+    // never destroyed, because timers with static storage duration may
+    // still stop themselves during their own destruction at exit
+    static vector<Timer*>* timers = new vector<Timer*>();
+    return *timers;
+}
+
+Timer::Timer(function<void()> callback)
+    : callback_(callback)
+{
+}
+
+Timer::~Timer() {
+    stop();
+}
+
+void Timer::start(long msecs) {
+    deadline_ = Clock::now() + milliseconds(std::max(0l, msecs));
+    if (!active_) {
+        active_ = true;
+        active_timers().push_back(this);
+    }
+}
+
+void Timer::stop() {
+    if (!active_) {
+        return;
+    }
+    active_ = false;
+    auto& timers = active_timers();
+    timers.erase(std::remove(timers.begin(), timers.end(), this), timers.end());
+}
+
+long Timer::msecsUntilNext() {
+    auto& timers = active_timers();
+    if (timers.empty()) {
+        return -1;
+    }
+    auto next = timers.front()->deadline_;
+    for (auto t : timers) {
+        next = std::min(next, t->deadline_);
+    }
+    auto msecs = duration_cast<milliseconds>(next - Clock::now()).count();
+    // round up, such that the timer really has expired after waiting
+    return std::max(0l, (long)msecs + 1);
+}
+
+void Timer::fireExpired() {
+    auto& timers = active_timers();
+    auto now = Clock::now();
+    // a callback may start or stop other timers, so search again after
+    // each callback
+    while (true) {
+        auto expired = std::find_if(timers.begin(), timers.end(),
+            [now](Timer* t) { return t->deadline_ <= now; });
+        if (expired == timers.end()) {
+            break;
+        }
+        Timer* t = *expired;
+        t->stop();
+        t->callback_();
+    }
+}
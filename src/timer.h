@@ -0,0 +1,32 @@
+#ifndef __HERBSTLUFT_TIMER_H_
+#define __HERBSTLUFT_TIMER_H_
+
+#include <chrono>
+#include <functional>
+
+/**
+ * A one-shot timer that is driven by the main loop: the main loop waits for
+ * X events at most until the next active timer expires and then calls the
+ * callbacks of all expired timers.
+ */
+class Timer {
+public:
+    using Clock = std::chrono::steady_clock;
+    Timer(std::function<void()> callback);
+    ~Timer();
+    //! (re)start the timer s.t. it fires once in msecs milliseconds
+    void start(long msecs);
+    void stop();
+    bool active() const { return active_; }
+
+    //! milliseconds until the next timer expires or -1 if there is none
+    static long msecsUntilNext();
+    //! call the callbacks of all expired timers
+    static void fireExpired();
+private:
+    std::function<void()> callback_;
+    Clock::time_point deadline_;
+    bool active_ = false;
+};
+
+#endif
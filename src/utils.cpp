@@ -4,7 +4,10 @@
 #include <X11/Xutil.h>
 #include <cstdlib>
 #include <cstring>
+#include <list>
+#include <map>
 #include <string>
+#include <tuple>
 #include <vector>
 
 #include "globals.h"
@@ -15,6 +18,8 @@
 #include <mach/mach.h>
 #endif
 
+using std::list;
+using std::pair;
 using std::shared_ptr;
 using std::string;
 using std::vector;
@@ -215,27 +220,68 @@ void* table_find(void* start, size_t elem_size, size_t count,
     return nullptr;
 }
 
+/**
+ * \brief   the border pixmaps created by set_window_double_border(). A pixmap
+ *          is never drawn to after creation, so it can be shared by all windows
+ *          with the same geometry and colors. The least recently used pixmap is
+ *          freed if there are too many.
+ */
+class BorderPixmapCache {
+public:
+    // width, height, border width, inner border width, depth, inner color,
+    // outer color
+    using Key = std::tuple<int, int, int, int, unsigned, unsigned long, unsigned long>;
+    static const size_t capacity = 32;
+
+    //! return the pixmap for the key or 0 if it is not cached
+    Pixmap find(const Key& key) {
+        auto it = index_.find(key);
+        if (it == index_.end()) {
+            return 0;
+        }
+        // mark it as most recently used
+        entries_.splice(entries_.begin(), entries_, it->second);
+        return it->second->second;
+    }
+    void insert(Display* dpy, const Key& key, Pixmap pixmap) {
+        if (entries_.size() >= capacity) {
+            XFreePixmap(dpy, entries_.back().second);
+            index_.erase(entries_.back().first);
+            entries_.pop_back();
+        }
+        entries_.push_front({key, pixmap});
+        index_[key] = entries_.begin();
+    }
+private:
+    list<pair<Key, Pixmap>> entries_; // most recently used first
+    std::map<Key, list<pair<Key, Pixmap>>::iterator> index_;
+};
+
+static BorderPixmapCache g_border_pixmaps;
+
 /**
  * \brief   emulates a double window border through the border pixmap mechanism
+ *
+ * \param width, height, bw, depth   the geometry and depth of the window win
+ *                                   as last set by the caller
  */
-void set_window_double_border(Display *dpy, Window win, int ibw,
+void set_window_double_border(Display *dpy, Window win,
+                              int width, int height, int bw, unsigned depth,
+                              int ibw,
                               unsigned long inner_color,
                               unsigned long outer_color)
 {
-    XWindowAttributes wa;
-
-    if (!XGetWindowAttributes(dpy, win, &wa))
-        return;
-
-    int bw = wa.border_width;
-
     if (bw < 2 || ibw >= bw || ibw < 1)
         return;
 
-    int width = wa.width;
-    int height = wa.height;
-
-    auto depth = (unsigned)wa.depth;
+    BorderPixmapCache::Key key {
+        width, height, bw, ibw, depth, inner_color, outer_color
+    };
+    Pixmap pix = g_border_pixmaps.find(key);
+    if (pix) {
+        XSetWindowBorderPixmap(dpy, win, pix);
+        return;
+    }
 
     int full_width = width + 2 * bw;
     int full_height = height + 2 * bw;
@@ -268,7 +314,7 @@ void set_window_double_border(Display *dpy, Window win, int ibw,
         { fw_ibw, fh_ibw, uibw, uibw }
     };
 
-    Pixmap pix = XCreatePixmap(dpy, win, full_width, full_height, depth);
+    pix = XCreatePixmap(dpy, win, full_width, full_height, depth);
     GC gc = XCreateGC(dpy, pix, 0, nullptr);
 
     /* outer border */
@@ -281,7 +327,7 @@ void set_window_double_border(Display *dpy, Window win, int ibw,
 
     XSetWindowBorderPixmap(dpy, win, pix);
     XFreeGC(dpy, gc);
-    XFreePixmap(dpy, pix);
+    g_border_pixmaps.insert(dpy, key, pix);
 }
 
 static void subtree_print_to(shared_ptr<TreeInterface> intface, const string& indent,
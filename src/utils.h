@@ -32,8 +32,6 @@ int MOD(int x, int n);
             (b) = TMPNAME; \
         } while(0);
 
-#define ATOM(A) XInternAtom(g_display, (A), False)
-
 class TreeInterface {
 public:
     TreeInterface() = default;
@@ -85,7 +83,9 @@ bool memberequals_int(void* pmember, const void* needle);
 void* table_find(void* start, size_t elem_size, size_t count,
                  size_t member_offset, MemberEquals equals, const void* needle);
 
-void set_window_double_border(Display *dpy, Window win, int ibw,
+void set_window_double_border(Display *dpy, Window win,
+                              int width, int height, int bw, unsigned depth,
+                              int ibw,
                               unsigned long inner_color, unsigned long outer_color);
 
 #define STATIC_TABLE_FIND(TYPE, TABLE, MEMBER, EQUALS, NEEDLE)  \
@@ -5,63 +5,44 @@
 #include <X11/extensions/shapeconst.h>
 
 #include "globals.h"
+#include "utils.h"
 
 /**
  * \brief   cut a rect out of the window, s.t. the window has geometry rect and
  * a frame of width framewidth remains
  */
 void window_cut_rect_hole(Window win, int width, int height, int framewidth) {
-    // inspired by the xhole.c example
-    // http://www.answers.com/topic/xhole-c
-    Display* d = g_display;
-    GC gp;
-    int bw = 100; // add a large border, just to be sure the border is visible
+    // the shape is slightly larger than the window to allow for the window
+    // border and title bar (as added by the window manager) to be visible
+    int bw = 100;
     int holewidth = width - 2*framewidth;
     int holeheight = height - 2*framewidth;
-    width += 2*bw;
-    height += 2*bw;
-
-    /* create the pixmap that specifies the shape */
-    Pixmap p = XCreatePixmap(d, win, width, height, 1);
-    gp = XCreateGC(d, p, 0, nullptr);
-    XSetForeground(d, gp, WhitePixel(d, g_screen));
-    XFillRectangle(d, p, gp, 0, 0, width, height);
-    XSetForeground(d, gp, BlackPixel(d, g_screen));
-    //int radius = 50;
-    //XFillArc(d, p, gp,
-    //         width/2 - radius, height/2 - radius, radius, radius,
-    //         0, 360*64);
-    XFillRectangle(d, p, gp, bw + framewidth, bw + framewidth,
-                             holewidth, holeheight);
-
-    /* set the pixmap as the new window mask;
-    the pixmap is slightly larger than the window to allow for the window
-    border and title bar (as added by the window manager) to be visible */
-    XShapeCombineMask(d, win, ShapeBounding, -bw, -bw, p, ShapeSet);
-    XFreeGC(d, gp);
-    XFreePixmap(d, p);
+    short x = -bw, y = -bw;
+    unsigned short full_width = width + 2*bw;
+    unsigned short full_height = height + 2*bw;
+    if (holewidth <= 0 || holeheight <= 0) {
+        XRectangle all = { x, y, full_width, full_height };
+        XShapeCombineRectangles(g_display, win, ShapeBounding, 0, 0,
+                                &all, 1, ShapeSet, YXBanded);
+        return;
+    }
+    // the frame around the hole, as bands from top to bottom
+    short hole_x = framewidth, hole_y = framewidth;
+    unsigned short margin = bw + framewidth;
+    unsigned short uhh = holeheight;
+    XRectangle frame[] = {
+        { x, y, full_width, margin },                               // top
+        { x, hole_y, margin, uhh },                                 // left
+        { (short)(hole_x + holewidth), hole_y, margin, uhh },       // right
+        { x, (short)(hole_y + holeheight), full_width, margin },    // bottom
+    };
+    XShapeCombineRectangles(g_display, win, ShapeBounding, 0, 0,
+                            frame, LENGTH(frame), ShapeSet, YXBanded);
 }
 
-void window_make_intransparent(Window win, int width, int height) {
-    // inspired by the xhole.c example
-    // http://www.answers.com/topic/xhole-c
-    Display* d = g_display;
-    GC gp;
-    int bw = 100; // add a large border, just to be sure the border is visible
-    width += 2*bw;
-    height += 2*bw;
-
-    /* create the pixmap that specifies the shape */
-    Pixmap p = XCreatePixmap(d, win, width, height, 1);
-    gp = XCreateGC(d, p, 0, nullptr);
-    XSetForeground(d, gp, WhitePixel(d, g_screen));
-    XFillRectangle(d, p, gp, 0, 0, width, height);
-    /* set the pixmap as the new window mask;
-    the pixmap is slightly larger than the window to allow for the window
-    border and title bar (as added by the window manager) to be visible */
-    XShapeCombineMask(d, win, ShapeBounding, -bw, -bw, p, ShapeSet);
-    XFreeGC(d, gp);
-    XFreePixmap(d, p);
+void window_make_intransparent(Window win) {
+    // remove the shape, such that the window is a plain rectangle again
+    XShapeCombineMask(g_display, win, ShapeBounding, 0, 0, None, ShapeSet);
 }
 
 
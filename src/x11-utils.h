@@ -9,7 +9,7 @@
 // of width framewidth remains
 void window_cut_rect_hole(Window win, int width, int height, int framewidth);
 // fill the hole again, i.e. remove all masks
-void window_make_intransparent(Window win, int width, int height);
+void window_make_intransparent(Window win);
 
 Point2D get_cursor_position();
 
@@ -4,11 +4,21 @@
 #include <X11/Xlib.h>
 #include <X11/Xproto.h>
 #include <X11/Xutil.h>
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
 
+#ifdef XCB
+#include <X11/Xlib-xcb.h>
+#include <xcb/xcb.h>
+#include <xcb/xproto.h>
+#endif
+
+#include "atoms.h"
 #include "globals.h"
 
 using std::endl;
+using std::function;
 using std::pair;
 using std::string;
 
@@ -18,6 +28,10 @@ XConnection::XConnection(Display* disp)
     m_screen_width = DisplayWidth(m_display, m_screen);
     m_screen_height = DisplayHeight(m_display, m_screen);
     m_root = RootWindow(m_display, m_screen);
+#ifdef XCB
+    // Xlib keeps owning the event queue, we only use XCB for requests
+    m_xcb = XGetXCBConnection(m_display);
+#endif
 }
 XConnection::~XConnection() {
     HSDebug("Closing display\n");
@@ -90,7 +104,7 @@ bool XConnection::checkotherwm() {
     }
 }
 
-Rectangle XConnection::windowSize(Window window) {
+Rectangle XConnection::windowSizeXlib(Window window) {
     unsigned int border, depth;
     int x, y;
     unsigned int w, h;
@@ -104,13 +118,13 @@ Atom XConnection::atom(const char* atom_name) {
 }
 
 //! The pid of a window or -1 if the pid is not set
-int XConnection::windowPid(Window window) {
+int XConnection::windowPidXlib(Window window) {
     Atom type;
     int format;
     unsigned long items, remain;
     int* buf;
     int status = XGetWindowProperty(m_display, window,
-        atom("_NET_WM_PID"), 0, 1, False,
+        g_atom[AtomNetWmPid], 0, 1, False,
         XA_CARDINAL, &type, &format,
         &items, &remain, (unsigned char**)&buf);
     if (items == 1 && format == 32 && remain == 0
@@ -124,7 +138,7 @@ int XConnection::windowPid(Window window) {
 }
 
 //! wrapper around XGetClassHint returning the window's instance and class name
-pair<string, string> XConnection::getClassHint(Window window) {
+pair<string, string> XConnection::getClassHintXlib(Window window) {
     XClassHint hint;
     if (0 == XGetClassHint(m_display, window, &hint)) {
         return {"", ""};
@@ -138,7 +152,7 @@ pair<string, string> XConnection::getClassHint(Window window) {
     return result;
 }
 
-std::experimental::optional<string> XConnection::getWindowProperty(Window window, Atom atom) {
+std::experimental::optional<string> XConnection::getWindowPropertyXlib(Window window, Atom atom) {
     string result;
     char** list = nullptr;
     int n = 0;
@@ -149,7 +163,7 @@ std::experimental::optional<string> XConnection::getWindowProperty(Window window
     }
     // convert text property to a gstring
     if (prop.encoding == XA_STRING
-        || prop.encoding == XInternAtom(m_display, "UTF8_STRING", False)) {
+        || prop.encoding == g_atom[AtomUtf8String]) {
         result = reinterpret_cast<char *>(prop.value);
     } else {
         if (XmbTextPropertyToTextList(m_display, &prop, &list, &n) >= Success
@@ -163,4 +177,146 @@ std::experimental::optional<string> XConnection::getWindowProperty(Window window
     return result;
 }
 
+#ifdef XCB
+//! return a discard function for a cookie of the given connection
+template<typename Cookie>
+static function<void()> xcb_discarder(xcb_connection_t* c, Cookie cookie) {
+    return [c, cookie]() { xcb_discard_reply(c, cookie.sequence); };
+}
+#endif
+
+XReply<Rectangle> XConnection::windowSizeAsync(Window window) {
+#ifdef XCB
+    if (m_xcb) {
+        xcb_connection_t* c = m_xcb;
+        auto cookie = xcb_get_geometry(c, window);
+        return { [c, cookie]() -> Rectangle {
+            xcb_get_geometry_reply_t* reply =
+                xcb_get_geometry_reply(c, cookie, nullptr);
+            if (!reply) {
+                return { 0, 0, 0, 0 };
+            }
+            Rectangle r = { reply->x, reply->y, reply->width, reply->height };
+            free(reply);
+            return r;
+        }, xcb_discarder(c, cookie) };
+    }
+#endif
+    return { [this, window]() { return windowSizeXlib(window); } };
+}
+
+XReply<int> XConnection::windowPidAsync(Window window) {
+#ifdef XCB
+    if (m_xcb) {
+        xcb_connection_t* c = m_xcb;
+        auto cookie = xcb_get_property(c, 0, window, g_atom[AtomNetWmPid],
+                                       XCB_ATOM_CARDINAL, 0, 1);
+        return { [c, cookie]() {
+            xcb_get_property_reply_t* reply =
+                xcb_get_property_reply(c, cookie, nullptr);
+            if (!reply) {
+                return -1;
+            }
+            int value = -1;
+            if (reply->type == XCB_ATOM_CARDINAL && reply->format == 32
+                && reply->bytes_after == 0
+                && xcb_get_property_value_length(reply) == 4)
+            {
+                value = *(int32_t*)xcb_get_property_value(reply);
+            }
+            free(reply);
+            return value;
+        }, xcb_discarder(c, cookie) };
+    }
+#endif
+    return { [this, window]() { return windowPidXlib(window); } };
+}
+
+XReply<Atom> XConnection::atomAsync(const char* atom_name) {
+#ifdef XCB
+    if (m_xcb) {
+        xcb_connection_t* c = m_xcb;
+        auto cookie = xcb_intern_atom(c, 0, strlen(atom_name), atom_name);
+        return { [c, cookie]() -> Atom {
+            xcb_intern_atom_reply_t* reply =
+                xcb_intern_atom_reply(c, cookie, nullptr);
+            if (!reply) {
+                return None;
+            }
+            Atom value = reply->atom;
+            free(reply);
+            return value;
+        }, xcb_discarder(c, cookie) };
+    }
+#endif
+    string name = atom_name;
+    return { [this, name]() { return atom(name.c_str()); } };
+}
+
+XReply<pair<string, string>> XConnection::getClassHintAsync(Window window) {
+#ifdef XCB
+    if (m_xcb) {
+        xcb_connection_t* c = m_xcb;
+        // WM_CLASS holds two consecutive null-terminated strings
+        auto cookie = xcb_get_property(c, 0, window, XCB_ATOM_WM_CLASS,
+                                       XCB_ATOM_STRING, 0, 2048);
+        return { [c, cookie]() -> pair<string, string> {
+            xcb_get_property_reply_t* reply =
+                xcb_get_property_reply(c, cookie, nullptr);
+            if (!reply) {
+                return {"", ""};
+            }
+            pair<string, string> result;
+            int len = xcb_get_property_value_length(reply);
+            if (reply->type == XCB_ATOM_STRING && reply->format == 8 && len > 0) {
+                const char* value = (const char*)xcb_get_property_value(reply);
+                size_t instance_len = strnlen(value, len);
+                result.first = string(value, instance_len);
+                if ((int)instance_len + 1 < len) {
+                    const char* cls = value + instance_len + 1;
+                    result.second = string(cls, strnlen(cls, len - instance_len - 1));
+                }
+            }
+            free(reply);
+            return result;
+        }, xcb_discarder(c, cookie) };
+    }
+#endif
+    return { [this, window]() { return getClassHintXlib(window); } };
+}
 
+XReply<std::experimental::optional<string>>
+XConnection::getWindowPropertyAsync(Window window, Atom atom_id) {
+#ifdef XCB
+    if (m_xcb) {
+        xcb_connection_t* c = m_xcb;
+        auto cookie = xcb_get_property(c, 0, window, atom_id,
+                                       XCB_GET_PROPERTY_TYPE_ANY, 0, UINT32_MAX / 4);
+        Atom utf8_string = g_atom[AtomUtf8String];
+        return { [this, c, cookie, window, atom_id, utf8_string]() {
+            using OptString = std::experimental::optional<string>;
+            xcb_get_property_reply_t* reply =
+                xcb_get_property_reply(c, cookie, nullptr);
+            if (!reply || reply->type == XCB_ATOM_NONE) {
+                free(reply);
+                return OptString();
+            }
+            if (reply->format == 8
+                && (reply->type == XCB_ATOM_STRING || reply->type == utf8_string))
+            {
+                const char* value = (const char*)xcb_get_property_value(reply);
+                int len = xcb_get_property_value_length(reply);
+                OptString result = string(value, strnlen(value, len));
+                free(reply);
+                return result;
+            }
+            free(reply);
+            // other encodings (e.g. COMPOUND_TEXT) need Xlib's conversion
+            return getWindowPropertyXlib(window, atom_id);
+        }, xcb_discarder(c, cookie) };
+    }
+#endif
+    return { [this, window, atom_id]() {
+        return getWindowPropertyXlib(window, atom_id);
+    } };
+}
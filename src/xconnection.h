@@ -3,11 +3,59 @@
 
 #include <X11/X.h>
 #include <X11/Xlib.h>
+#include <functional>
 #include <string>
 
 #include "optional.h"
 #include "x11-types.h"
 
+struct xcb_connection_t;
+
+/**
+ * The reply of a request that already has been sent to the X server, but
+ * whose answer is only waited for when calling get(). This allows to issue
+ * several requests first and to collect all the replies afterwards, which
+ * costs a single round trip instead of one per request.
+ *
+ * If the reply is never asked for, it is discarded on destruction.
+ */
+template<typename T>
+class XReply {
+public:
+    XReply(std::function<T()> collect, std::function<void()> discard = {})
+        : collect_(collect)
+        , discard_(discard)
+        , value_()
+    {}
+    XReply(XReply&& other)
+        : collect_(std::move(other.collect_))
+        , discard_(std::move(other.discard_))
+        , value_(std::move(other.value_))
+    {
+        other.collect_ = nullptr;
+        other.discard_ = nullptr;
+    }
+    XReply(const XReply&) = delete;
+    XReply& operator=(const XReply&) = delete;
+    ~XReply() {
+        if (collect_ && discard_) {
+            discard_();
+        }
+    }
+    //! wait for the reply (only on the first call) and return it
+    T get() {
+        if (collect_) {
+            value_ = collect_();
+            collect_ = nullptr;
+        }
+        return value_;
+    }
+private:
+    std::function<T()> collect_;
+    std::function<void()> discard_;
+    T value_;
+};
+
 class XConnection {
 private:
     XConnection(Display* disp);
@@ -15,6 +63,8 @@ public:
     ~XConnection();
     static XConnection* connect(std::string display_name = {});
     Display* display() { return m_display; }
+    //! the XCB connection beneath display(), or nullptr if built without XCB
+    xcb_connection_t* xcb() { return m_xcb; }
     int screen() { return m_screen; }
     Window root() { return m_root; }
     Window screenWidth() { return m_screen_width; }
@@ -22,15 +72,34 @@ public:
     bool checkotherwm(); // return whether another WM is running
 
     // utility functions
-    Rectangle windowSize(Window window);
-    int windowPid(Window window);
+    Rectangle windowSize(Window window) { return windowSizeAsync(window).get(); }
+    int windowPid(Window window) { return windowPidAsync(window).get(); }
     Atom atom(const char* atom_name);
-    std::pair<std::string, std::string> getClassHint(Window win);
+    std::pair<std::string, std::string> getClassHint(Window win) {
+        return getClassHintAsync(win).get();
+    }
     std::string getInstance(Window win) { return getClassHint(win).first; };
     std::string getClass(Window win) { return getClassHint(win).second; };
-    std::experimental::optional<std::string> getWindowProperty(Window window, Atom atom);
+    std::experimental::optional<std::string> getWindowProperty(Window window, Atom atom) {
+        return getWindowPropertyAsync(window, atom).get();
+    }
+
+    // asynchronous variants of the above. Without XCB, the request is only
+    // sent when the reply is asked for.
+    XReply<Rectangle> windowSizeAsync(Window window);
+    XReply<int> windowPidAsync(Window window);
+    XReply<Atom> atomAsync(const char* atom_name);
+    XReply<std::pair<std::string, std::string>> getClassHintAsync(Window win);
+    XReply<std::experimental::optional<std::string>>
+        getWindowPropertyAsync(Window window, Atom atom);
 private:
+    Rectangle windowSizeXlib(Window window);
+    int windowPidXlib(Window window);
+    std::pair<std::string, std::string> getClassHintXlib(Window win);
+    std::experimental::optional<std::string> getWindowPropertyXlib(Window window, Atom atom);
+
     Display* m_display;
+    xcb_connection_t* m_xcb = nullptr;
     int      m_screen;
     Window   m_root;
     int      m_screen_width;
@@ -30,6 +30,63 @@ void XKeyGrabber::updateNumlockMask() {
         }
     }
     XFreeModifiermap(modmap);
+    if (ignoreLockMods_) {
+        applyIgnoreLockMods();
+    }
+}
+
+/*!
+ * Adds the lock modifiers to the XKB control IgnoreLockMods, such that the X
+ * server ignores them when activating passive grabs, or restores the
+ * previous value of the control.
+ *
+ * \return False if XKB is not available (then all lock modifier
+ *         combinations have to be grabbed)
+ */
+bool XKeyGrabber::setIgnoreLockMods(bool ignore) {
+    if (ignore == ignoreLockMods_) {
+        return true;
+    }
+    if (!ignore) {
+        XkbSetIgnoreLockMods(g_display, XkbUseCoreKbd, 0xff, savedIgnoreLockMods_, 0, 0);
+        ignoreLockMods_ = false;
+        return true;
+    }
+    int opcode, event, error;
+    int major = XkbMajorVersion, minor = XkbMinorVersion;
+    if (!XkbQueryExtension(g_display, &opcode, &event, &error, &major, &minor)) {
+        return false;
+    }
+    XkbDescPtr xkb = XkbAllocKeyboard();
+    if (!xkb) {
+        return false;
+    }
+    if (XkbGetControls(g_display, XkbIgnoreLockModsMask, xkb) != Success) {
+        XkbFreeKeyboard(xkb, 0, True);
+        return false;
+    }
+    savedIgnoreLockMods_ = xkb->ctrls->ignore_lock.real_mods;
+    XkbFreeKeyboard(xkb, 0, True);
+    ignoreLockMods_ = true;
+    applyIgnoreLockMods();
+    return true;
+}
+
+//! Adds the current lock modifiers to the ones ignored by the X server
+void XKeyGrabber::applyIgnoreLockMods() {
+    unsigned int mods = savedIgnoreLockMods_ | LockMask | numlockMask_;
+    XkbSetIgnoreLockMods(g_display, XkbUseCoreKbd, 0xff, mods, 0, 0);
+}
+
+/*!
+ * The lock modifiers a binding has to be grabbed with such that it also
+ * triggers if CapsLock or NumLock is active
+ */
+vector<unsigned int> XKeyGrabber::lockModifierCombinations() const {
+    if (ignoreLockMods_) {
+        return { 0 };
+    }
+    return { 0, LockMask, numlockMask_, numlockMask_ | LockMask };
 }
 
 /*!
@@ -49,14 +106,25 @@ KeyCombo XKeyGrabber::xEventToKeyCombo(XEvent *ev) const {
     return combo;
 }
 
-//! Grabs the given key combo
-void XKeyGrabber::grabKeyCombo(const KeyCombo& keyCombo) {
-    changeGrabbedState(keyCombo, true);
+//! The keycode that currently produces the keysym of the given key combo
+KeyCode XKeyGrabber::keycodeFor(const KeyCombo& keyCombo) const {
+    return XKeysymToKeycode(g_display, keyCombo.keysym);
+}
+
+/*!
+ * Grabs the given key combo
+ *
+ * \return the grabbed keycode, or 0 if the keysym is unknown
+ */
+KeyCode XKeyGrabber::grabKeyCombo(const KeyCombo& keyCombo) {
+    KeyCode keycode = keycodeFor(keyCombo);
+    changeGrabbedState(keycode, keyCombo.modifiers, true);
+    return keycode;
 }
 
-//! Ungrabs the given key combo
-void XKeyGrabber::ungrabKeyCombo(const KeyCombo& keyCombo) {
-    changeGrabbedState(keyCombo, false);
+//! Ungrabs the given key combo, which was grabbed with the given keycode
+void XKeyGrabber::ungrabKeyCombo(const KeyCombo& keyCombo, KeyCode keycode) {
+    changeGrabbedState(keycode, keyCombo.modifiers, false);
 }
 
 //! Removes all grabbed keys (without knowing them)
@@ -64,12 +132,11 @@ void XKeyGrabber::ungrabAll() {
     XUngrabKey(g_display, AnyKey, AnyModifier, g_root);
 }
 
-//! Grabs/ungrabs a given key combo
-void XKeyGrabber::changeGrabbedState(const KeyCombo& keyCombo, bool grabbed) {
+//! Grabs/ungrabs a given keycode with the given modifiers
+void XKeyGrabber::changeGrabbedState(KeyCode keycode, unsigned int modifiers, bool grabbed) {
     // List of ignored modifiers (key combo will be grabbed for each of them):
-    const unsigned int ignModifiers[] = { 0, LockMask, numlockMask_, numlockMask_ | LockMask };
+    const auto ignModifiers = lockModifierCombinations();
 
-    KeyCode keycode = XKeysymToKeycode(g_display, keyCombo.keysym);
     if (!keycode) {
         // Ignore unknown keysym
         return;
@@ -78,10 +145,10 @@ void XKeyGrabber::changeGrabbedState(const KeyCombo& keyCombo, bool grabbed) {
     // Grab/ungrab key for each modifier that is ignored (capslock, numlock)
     for (auto& ignModifier : ignModifiers) {
         if (grabbed) {
-            XGrabKey(g_display, keycode, ignModifier | keyCombo.modifiers, g_root,
+            XGrabKey(g_display, keycode, ignModifier | modifiers, g_root,
                     True, GrabModeAsync, GrabModeAsync);
         } else {
-            XUngrabKey(g_display, keycode, ignModifier | keyCombo.modifiers, g_root);
+            XUngrabKey(g_display, keycode, ignModifier | modifiers, g_root);
         }
     }
 }
@@ -19,10 +19,14 @@ public:
 
     void updateNumlockMask();
 
+    bool setIgnoreLockMods(bool ignore);
+    std::vector<unsigned int> lockModifierCombinations() const;
+
     KeyCombo xEventToKeyCombo(XEvent *ev) const;
 
-    void grabKeyCombo(const KeyCombo& keyCombo);
-    void ungrabKeyCombo(const KeyCombo& keyCombo);
+    KeyCode keycodeFor(const KeyCombo& keyCombo) const;
+    KeyCode grabKeyCombo(const KeyCombo& keyCombo);
+    void ungrabKeyCombo(const KeyCombo& keyCombo, KeyCode keycode);
     void ungrabAll();
 
     // TODO: This is not supposed to exist. It only does as a workaround,
@@ -34,8 +38,14 @@ public:
     static std::vector<std::string> getPossibleKeySyms();
 
 private:
-    void changeGrabbedState(const KeyCombo& keyCombo, bool grabbed);
+    void changeGrabbedState(KeyCode keycode, unsigned int modifiers, bool grabbed);
+    void applyIgnoreLockMods();
     unsigned int numlockMask_ = 0;
 
+    // whether the X server ignores the lock modifiers for passive grabs, and
+    // the value of the XKB control before we changed it
+    bool ignoreLockMods_ = false;
+    unsigned int savedIgnoreLockMods_ = 0;
+
 };
 
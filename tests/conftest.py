@@ -8,6 +8,7 @@ import shlex
 import subprocess
 import sys
 import textwrap
+import time
 import types
 
 import pytest
@@ -116,6 +117,15 @@ class HlwmBridge:
     def get_attr(self, attribute_path, check=True):
         return self.call(['get_attr', attribute_path]).stdout
 
+    def wait_for_attr(self, attribute_path, value, timeout=10):
+        """poll the attribute until it has the given value, for changes that
+        happen asynchronously, e.g. after a timer or a client's exit"""
+        deadline = time.monotonic() + timeout
+        while self.get_attr(attribute_path) != value \
+                and time.monotonic() < deadline:
+            time.sleep(0.1)
+        assert self.get_attr(attribute_path) == value
+
     def create_client(self, term_command='sleep infinity', title=None, keep_running=False):
         """
         Launch a client that will be terminated on shutdown.
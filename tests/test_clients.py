@@ -84,3 +84,16 @@ def test_urgent_jumpto_resets_urgent_flag(hlwm, x11, explicit_winid):
 
     assert hlwm.get_attr('clients.focus.winid') == winid
     assert hlwm.get_attr('clients.focus.urgent') == 'false'
+
+
+def test_focus_follows_mouse_delay(hlwm, mouse):
+    hlwm.call('set focus_follows_mouse on')
+    hlwm.call('set focus_follows_mouse_delay 300')
+    c1, c2 = hlwm.create_clients(2)
+    hlwm.call(['jumpto', c1])
+
+    mouse.move_into(c2)
+
+    assert hlwm.get_attr('clients.focus.winid') == c1
+    # the exact time of the focus change depends on the load
+    hlwm.wait_for_attr('clients.focus.winid', c2)
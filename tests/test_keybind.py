@@ -55,6 +55,29 @@ def test_keyunbind_all(hlwm, method, keyboard):
     keyboard.press('Alt+x')  # verify that key got ungrabbed
 
 
+def test_source_applies_grabs_at_the_end(hlwm, keyboard, tmpdir):
+    hlwm.call('keybind y use tag2')
+    hlwm.call('add tag2')
+    hlwm.call('add tag3')
+    path = tmpdir / 'keybinds'
+    path.write('\n'.join([
+        'keyunbind --all',
+        'keybind x use tag2',
+        'keybind y use tag3',
+        'keybind z quit',
+        'keyunbind z',
+    ]) + '\n')
+
+    hlwm.call(['source', str(path)])
+
+    assert hlwm.call('list_keybinds').stdout == 'x\tuse tag2\ny\tuse tag3\n'
+    keyboard.press('x')
+    assert hlwm.get_attr('tags.focus.name') == 'tag2'
+    keyboard.press('y')
+    assert hlwm.get_attr('tags.focus.name') == 'tag3'
+    keyboard.press('z')  # verify that key got ungrabbed
+
+
 def test_keyunbind_nonexistent_binding(hlwm):
     unbind = hlwm.call('keyunbind n')
 
@@ -71,6 +94,23 @@ def test_trigger_single_key_binding(hlwm, keyboard):
     assert hlwm.get_attr('monitors.0.tag') == 'tag2'
 
 
+@pytest.mark.parametrize('bind_before_setting', [True, False])
+def test_xkb_ignore_lock_mods_keeps_bindings_working(hlwm, keyboard, bind_before_setting):
+    hlwm.call('add tag2')
+    if bind_before_setting:
+        hlwm.call('keybind x use_index +1')
+    hlwm.call('set xkb_ignore_lock_mods true')
+    if not bind_before_setting:
+        hlwm.call('keybind x use_index +1')
+
+    keyboard.press('x')
+    assert hlwm.get_attr('tags.focus.name') == 'tag2'
+
+    hlwm.call('set xkb_ignore_lock_mods false')
+    keyboard.press('x')
+    assert hlwm.get_attr('tags.focus.name') == 'default'
+
+
 def test_trigger_selfremoving_binding(hlwm, keyboard):
     hlwm.call('keybind x keyunbind x')
 
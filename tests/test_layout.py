@@ -220,3 +220,45 @@ def test_cycle_frame_traverses_all(hlwm, running_clients, num_splits, delta):
     for i1 in range(0, len(layouts)):
         for i2 in range(0, i1):
             assert layouts[i1] != layouts[i2]
+
+
+def test_max_layout_configures_client_on_selection(hlwm, x11):
+    hlwm.call('set_layout vertical')
+    winid1, _ = hlwm.create_client()
+    winid2, _ = hlwm.create_client()
+    hlwm.call('set_layout max')
+
+    hlwm.call(['jumpto', winid1])
+    geometry1 = x11.window(winid1).get_geometry()
+    hlwm.call(['jumpto', winid2])
+    geometry2 = x11.window(winid2).get_geometry()
+
+    # both clients got the full frame size when being selected
+    assert (geometry1.width, geometry1.height) \
+        == (geometry2.width, geometry2.height)
+
+
+@pytest.mark.parametrize('pseudotile', [True, False])
+def test_max_layout_cycle_selection_final_geometry(hlwm, x11, pseudotile):
+    hlwm.call('set_layout vertical')
+    winids = [hlwm.create_client()[0] for _ in range(3)]
+    hlwm.call(['jumpto', winids[0]])
+    if pseudotile:
+        hlwm.call('pseudotile on')
+    vertical_height = x11.window(winids[1]).get_geometry().height
+
+    hlwm.call('set_layout max')
+    if pseudotile:
+        # the pseudotiled client does not hide the others, so they are
+        # configured immediately
+        assert x11.window(winids[1]).get_geometry().height > vertical_height
+    for _ in winids:
+        hlwm.call('cycle')
+
+    sizes = []
+    for winid in winids[1:]:
+        geometry = x11.window(winid).get_geometry()
+        sizes.append((geometry.x, geometry.y, geometry.width, geometry.height))
+    assert sizes[0] == sizes[1]
+    assert sizes[0][3] > vertical_height
+    assert hlwm.get_attr('clients.focus.winid') == winids[0]
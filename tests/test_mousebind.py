@@ -1,4 +1,5 @@
 import pytest
+import subprocess
 
 # Note: For unknown reasons, mouse buttons 4 and 5 (scroll wheel) do not work
 # in Xvfb when running tests on Travis. Therefore, we maintain two lists of
@@ -96,3 +97,25 @@ def test_complete_mousebind_validates_all_button(hlwm):
     complete = hlwm.complete('mousebind Moo+Mo', partial=True, position=1)
 
     assert complete == []
+
+
+@pytest.mark.parametrize('rate,max_updates', [(0, 5), (1, 2)])
+def test_drag_statistics(hlwm, mouse, rate, max_updates):
+    hlwm.call('floating on')
+    hlwm.call(f'set drag_update_rate {rate}')
+    hlwm.call('mousebind Button1 move')
+    winid, _ = hlwm.create_client()
+    mouse.move_into(winid)
+
+    subprocess.check_call(['xdotool', 'mousedown', '1'])
+    hlwm.call('true')  # wait until the drag started
+    for _ in range(5):
+        subprocess.check_call(['xdotool', 'mousemove_relative', '--sync', '10', '10'])
+        hlwm.call('true')
+    subprocess.check_call(['xdotool', 'mouseup', '1'])
+    hlwm.call('true')
+
+    updates = int(hlwm.get_attr('mouse.drag_updates'))
+    assert 1 <= updates <= max_updates
+    assert int(hlwm.get_attr('mouse.drag_latency_max')) \
+        >= int(hlwm.get_attr('mouse.drag_latency_avg'))
@@ -238,3 +238,65 @@ def test_getenv_completion(hlwm):
     hlwm.call(['setenv', name, 'myvalue'])
 
     assert [name] == hlwm.complete('getenv ' + prefix, position=1)
+
+
+def test_source_executes_lines(hlwm, tmpdir):
+    path = tmpdir / 'commands'
+    path.write('\n'.join([
+        '# a comment',
+        'new_attr string my_foo',
+        '',
+        "set_attr my_foo 'hello world'  # trailing comment",
+        'new_attr int \\',
+        '    my_bar',
+    ]) + '\n')
+
+    hlwm.call(['source', str(path)])
+
+    assert hlwm.get_attr('my_foo') == 'hello world'
+    assert hlwm.get_attr('my_bar') == '0'
+
+
+def test_source_reports_failing_lines(hlwm, tmpdir):
+    path = tmpdir / 'commands'
+    path.write('\n'.join([
+        'new_attr string my_foo',
+        'set_attr my_nonexisting bar',
+        'set_attr my_foo "unterminated',
+        'set_attr my_foo done',
+    ]) + '\n')
+
+    proc = hlwm.call_xfail(['source', str(path)])
+
+    assert proc.stderr.startswith(str(path) + ':2: ')
+    assert (str(path) + ':3: unterminated quote') in proc.stderr
+    assert hlwm.get_attr('my_foo') == 'done'
+
+
+def test_source_missing_file(hlwm, tmpdir):
+    hlwm.call_xfail(['source', str(tmpdir / 'nonexisting')]) \
+        .expect_stderr('Can not open')
+
+
+def test_source_escaped_backslash_ends_line(hlwm, tmpdir):
+    path = tmpdir / 'commands'
+    path.write('\n'.join([
+        'new_attr string my_foo',
+        'new_attr string my_bar',
+        'set_attr my_foo foo\\\\',
+        'set_attr my_bar bar',
+    ]) + '\n')
+
+    hlwm.call(['source', str(path)])
+
+    assert hlwm.get_attr('my_foo') == 'foo\\'
+    assert hlwm.get_attr('my_bar') == 'bar'
+
+
+def test_source_recursion_is_limited(hlwm, tmpdir):
+    path = tmpdir / 'commands'
+    path.write(f'source {path}\n')
+
+    hlwm.call_xfail(['source', str(path)]) \
+        .expect_stderr('nested deeper than')
+    hlwm.call('true')  # herbstluftwm is still alive
@@ -3,12 +3,16 @@ import pytest
 
 can_toggle = [
     'update_dragged_clients',
+    'tag_containers',
+    'xkb_ignore_lock_mods',
 ]
 
 cannot_toggle = [
     'window_border_width',
     'frame_border_active_color',
     'default_frame_layout',
+    'drag_update_rate',
+    'focus_follows_mouse_delay',
     'wmname'
 ]
 
@@ -45,3 +49,15 @@ def test_toggle_completion(hlwm):
         assert n in res
     for n in cannot_toggle:
         assert n not in res
+
+
+def test_drag_update_rate_not_negative(hlwm):
+    hlwm.call('set drag_update_rate 0')
+    hlwm.call_xfail('set drag_update_rate -1')
+    assert hlwm.get_attr('settings.drag_update_rate') == '0'
+
+
+def test_focus_follows_mouse_delay_not_negative(hlwm):
+    hlwm.call('set focus_follows_mouse_delay 0')
+    hlwm.call_xfail('set focus_follows_mouse_delay -1')
+    assert hlwm.get_attr('settings.focus_follows_mouse_delay') == '0'
@@ -51,3 +51,52 @@ def test_merge_tag_into_another_tag(hlwm):
 
     assert hlwm.get_attr('tags.count') == '1'
     assert hlwm.get_attr('tags.0.name') == 'foobar'
+
+
+def test_merge_tag_then_focus_and_close_client(hlwm):
+    hlwm.call('add foobar')
+    winid, proc = hlwm.create_client()
+    hlwm.call('use foobar')
+
+    hlwm.call('merge_tag default foobar')
+    hlwm.call(['jumpto', winid])
+
+    assert hlwm.get_attr('clients.focus.winid') == winid
+    assert hlwm.get_attr('tags.focus.client_count') == '1'
+    hlwm.call('close')
+    proc.wait(10)
+    hlwm.wait_for_attr('tags.focus.client_count', '0')
+    hlwm.call_xfail('get_attr clients.focus.winid')
+
+
+def test_tag_status_used_flag_follows_client(hlwm):
+    hlwm.call('add foobar')
+    assert hlwm.call('tag_status').stdout == '\t#default\t.foobar\t'
+
+    hlwm.create_client()
+    hlwm.call('move foobar')
+    assert hlwm.call('tag_status').stdout == '\t#default\t:foobar\t'
+
+    hlwm.call(['use', 'foobar'])
+    hlwm.call(['move', 'default'])
+    assert hlwm.call('tag_status').stdout == '\t:default\t#foobar\t'
+
+
+@pytest.mark.parametrize('containers', [True, False])
+def test_use_tag_hides_clients(hlwm, x11, containers):
+    from Xlib import X
+    hlwm.call(['set', 'tag_containers', hlwm.bool(containers)])
+    hlwm.call('add foobar')
+    winid, _ = hlwm.create_client()
+    window = x11.window(winid)
+    assert window.get_attributes().map_state == X.IsViewable
+
+    hlwm.call('use foobar')
+    assert window.get_attributes().map_state != X.IsViewable
+
+    # switching the mode keeps the client hidden
+    hlwm.call('toggle tag_containers')
+    assert window.get_attributes().map_state != X.IsViewable
+
+    hlwm.call('use default')
+    assert window.get_attributes().map_state == X.IsViewable